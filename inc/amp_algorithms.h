@@ -24,11 +24,16 @@
 
 #pragma once
 
+#if defined(_MSC_VER) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
 #include <amp.h>
+#else
+#include <xx_amp_algorithms_host_impl.h>
+#endif
 
-#include <xx_amp_algorithms_impl.h>
-#include <xx_amp_stl_algorithms_impl_inl.h>
+#include <limits>
+#include <xx_amp_algorithms_impl_inl.h>
 #include <amp_indexable_view.h>
+#include <xx_amp_algorithms_host_keywords_push.h>
 
 namespace amp_algorithms
 {
@@ -115,21 +120,6 @@ namespace amp_algorithms
         enum { value = P };
     };
 
-    template<unsigned int N>
-    struct is_power_of_two
-    {
-        enum { value = ((count_bits<N, _details::bit32>::value == 1) ? TRUE : FALSE) };
-    };
-
-    // While 1 is technically 2^0, for the purposes of calculating 
-    // tile size it isn't useful.
-
-    template <>
-    struct is_power_of_two<1>
-    {
-        enum { value = FALSE };
-    };
-
     //----------------------------------------------------------------------------
     // Bitwise operations
     //----------------------------------------------------------------------------
@@ -170,7 +160,7 @@ namespace amp_algorithms
         static const unsigned int bit16 = 0x8000;
         static const unsigned int bit32 = 0x80000000;
 
-        template<unsigned int N, int MaxBit>
+        template<unsigned int N, unsigned int MaxBit>
         struct is_bit_set
         {
             enum { value = (N & MaxBit) ? 1 : 0 };
@@ -186,7 +176,22 @@ namespace amp_algorithms
     template<unsigned int N>
     struct count_bits<N, 0>
     {
-        enum { value = FALSE };
+        enum { value = 0 };
+    };
+
+    template<unsigned int N>
+    struct is_power_of_two
+    {
+        enum { value = ((count_bits<N, _details::bit32>::value == 1) ? 1 : 0) };
+    };
+
+    // While 1 is technically 2^0, for the purposes of calculating 
+    // tile size it isn't useful.
+
+    template <>
+    struct is_power_of_two<1>
+    {
+        enum { value = 0 };
     };
 
     //----------------------------------------------------------------------------
@@ -319,6 +324,61 @@ namespace amp_algorithms
 
     // TODO: Implement not1() and not2() if appropriate.
 
+    //----------------------------------------------------------------------------
+    // Identity elements
+    //
+    // operator_identity<Op>::value() is the value e for which op(e, x) == x. Scan uses it to pad partial tiles and as
+    // the first result of an exclusive scan. Specialize it for your own operators or pass the identity explicitly.
+    //----------------------------------------------------------------------------
+
+    template <typename BinaryFunction>
+    struct operator_identity
+    {
+        static_assert(sizeof(BinaryFunction) == 0, "No identity is defined for this operator, specialize operator_identity or pass the identity explicitly.");
+    };
+
+    template <typename T>
+    struct operator_identity<plus<T>>
+    {
+        static T value() { return T(0); }
+    };
+
+    template <typename T>
+    struct operator_identity<multiplies<T>>
+    {
+        static T value() { return T(1); }
+    };
+
+    template <typename T>
+    struct operator_identity<max<T>>
+    {
+        static T value() { return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest(); }
+    };
+
+    template <typename T>
+    struct operator_identity<min<T>>
+    {
+        static T value() { return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : (std::numeric_limits<T>::max)(); }
+    };
+
+    template <typename T>
+    struct operator_identity<bit_and<T>>
+    {
+        static T value() { return T(~T(0)); }
+    };
+
+    template <typename T>
+    struct operator_identity<bit_or<T>>
+    {
+        static T value() { return T(0); }
+    };
+
+    template <typename T>
+    struct operator_identity<bit_xor<T>>
+    {
+        static T value() { return T(0); }
+    };
+
     //----------------------------------------------------------------------------
     // Byte pack and unpack
     //----------------------------------------------------------------------------
@@ -326,12 +386,12 @@ namespace amp_algorithms
     template<int index>
     inline unsigned pack_byte(const unsigned value) restrict(cpu, amp)
     {
-        return (value && 0xFF) << (index * 8);
+        return (value & 0xFF) << (index * 8);
     }
 
     inline unsigned pack_byte(const unsigned value, unsigned index) restrict(cpu, amp)
     {
-        return (value && 0xFF) << (index * 8);
+        return (value & 0xFF) << (index * 8);
     }
 
     template<int index>
@@ -377,22 +437,13 @@ namespace amp_algorithms
     {
         padded_write<InputIndexableView, 1>(arr, concurrency::index<1>(idx), value);
     }
+} // namespace amp_algorithms
 
-    //----------------------------------------------------------------------------
-    // fill
-    //----------------------------------------------------------------------------
-
-    template<typename OutputIndexableView, typename T>
-    void fill(const concurrency::accelerator_view &accl_view, OutputIndexableView& output_view, const T& value)
-    {
-        ::amp_algorithms::generate(accl_view, output_view, [value]() restrict(amp) { return value; });
-    }
+// The implementation details depend on the operators and padded accessors above.
+#include <xx_amp_algorithms_impl.h>
 
-    template<typename OutputIndexableView, typename T>
-    void fill(OutputIndexableView& output_view, const T& value)
-    {
-        ::amp_algorithms::generate(output_view, [value]() restrict(amp) { return value; });
-    }
+namespace amp_algorithms
+{
 
     //----------------------------------------------------------------------------
     // generate
@@ -412,23 +463,52 @@ namespace amp_algorithms
         ::amp_algorithms::generate(_details::auto_select_target(), output_view, generator);
     }
 
+    //----------------------------------------------------------------------------
+    // fill
+    //----------------------------------------------------------------------------
+
+    template<typename OutputIndexableView, typename T>
+    void fill(const concurrency::accelerator_view &accl_view, OutputIndexableView& output_view, const T& value)
+    {
+        ::amp_algorithms::generate(accl_view, output_view, [value]() restrict(amp) { return value; });
+    }
+
+    template<typename OutputIndexableView, typename T>
+    void fill(OutputIndexableView& output_view, const T& value)
+    {
+        ::amp_algorithms::generate(output_view, [value]() restrict(amp) { return value; });
+    }
+
     //----------------------------------------------------------------------------
     // merge_sort
     //----------------------------------------------------------------------------
 
-    // TODO: NOT IMPLEMENTED radix_sort
+    // Stable sort of the elements into the order given by op, a strict weak ordering of T. Use radix_sort for keys it
+    // supports and merge_sort for other element types and orderings.
     template <typename T, typename BinaryOperator>
-    void merge_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<unsigned int>& input_view, BinaryOperator op)
+    void merge_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<T>& input_view, const BinaryOperator& op)
     {
+        ::amp_algorithms::_details::merge_sort<_details::merge_tile_size, _details::merge_items_per_thread>(accl_view, input_view, op);
+    }
+
+    template <typename T, typename BinaryOperator>
+    void merge_sort(concurrency::array_view<T>& input_view, const BinaryOperator& op)
+    {
+        ::amp_algorithms::merge_sort(_details::auto_select_target(), input_view, op);
     }
 
-    // TODO: NOT IMPLEMENTED radix_sort
     template <typename T>
-    void merge_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<unsigned int>& input_view)
+    void merge_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<T>& input_view)
     {
         ::amp_algorithms::merge_sort(accl_view, input_view, amp_algorithms::less<T>());
     }
 
+    template <typename T>
+    void merge_sort(concurrency::array_view<T>& input_view)
+    {
+        ::amp_algorithms::merge_sort(_details::auto_select_target(), input_view, amp_algorithms::less<T>());
+    }
+
     //----------------------------------------------------------------------------
     // radix_sort
     //----------------------------------------------------------------------------
@@ -445,6 +525,20 @@ namespace amp_algorithms
     //
     // "Histogram Calculation in CUDA" http://docs.nvidia.com/cuda/samples/3_Imaging/histogram/doc/histogram.pdf
     //
+    // 64 bit keys for radix_sort. C++ AMP has no 64 bit integer type so these keys are stored as two 32 bit words, which
+    // matches the layout of unsigned long long and long long on little endian hosts.
+    struct uint64_key
+    {
+        unsigned int low;
+        unsigned int high;
+    };
+
+    struct int64_key
+    {
+        unsigned int low;
+        int high;
+    };
+
     // TODO: Move this to the impl file?
     namespace _details
     {
@@ -456,199 +550,603 @@ namespace amp_algorithms
             return (value >> key_offset) & mask;
         }
 
-        // TODO: T is limited to only integer types. Need to modify the template to restrict this.
-        template <typename T, int key_bit_width, int tile_size>
-        void radix_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<T>& input_view)
+        // Maps a key to unsigned words that compare in the same order as the key, word 0 is the least significant.
+        template <typename T>
+        struct radix_key_traits
         {
-        }
+            static_assert((sizeof(T) == 0), "radix_sort only supports int, unsigned int, float, int64_key and uint64_key keys.");
+        };
 
-        template <typename T>
-        inline void initialize_bins(T* const bin_data, const int bin_count) restrict(amp)
+        template <>
+        struct radix_key_traits<unsigned int>
         {
-            for (int b = 0; b < bin_count; ++b)
+            static const int word_count = 1;
+
+            static unsigned int word(const unsigned int& key, const int) restrict(cpu, amp)
             {
-                bin_data[b] = T(0);
+                return key;
             }
-        }
+        };
 
-        template<typename T>
-        inline void merge_bins(T* const left, const T* const right, const int bin_count) restrict(amp)
+        template <>
+        struct radix_key_traits<int>
         {
-            for (int b = 0; b < bin_count; ++b)
+            static const int word_count = 1;
+
+            // Flip the sign bit so negative values come first.
+            static unsigned int word(const int& key, const int) restrict(cpu, amp)
             {
-                left[b] += right[b];
+                return static_cast<unsigned int>(key) ^ 0x80000000;
             }
+        };
+
+        template <>
+        struct radix_key_traits<float>
+        {
+            static const int word_count = 1;
+
+            // Flip the sign bit of positive values and all the bits of negative values, so larger negative values come first.
+            static unsigned int word(const float& key, const int) restrict(amp)
+            {
+                const unsigned int bits = concurrency::direct3d::asuint(key);
+                return bits ^ (((bits & 0x80000000) != 0) ? 0xFFFFFFFF : 0x80000000);
+            }
+        };
+
+        template <>
+        struct radix_key_traits<uint64_key>
+        {
+            static const int word_count = 2;
+
+            static unsigned int word(const uint64_key& key, const int word_idx) restrict(cpu, amp)
+            {
+                return (word_idx == 0) ? key.low : key.high;
+            }
+        };
+
+        template <>
+        struct radix_key_traits<int64_key>
+        {
+            static const int word_count = 2;
+
+            static unsigned int word(const int64_key& key, const int word_idx) restrict(cpu, amp)
+            {
+                return (word_idx == 0) ? key.low : (static_cast<unsigned int>(key.high) ^ 0x80000000);
+            }
+        };
+
+        // Returns the digit_idx'th digit of key, digits may span the words of 64 bit keys.
+        template <typename T, int digit_width>
+        inline unsigned int radix_key_digit(const T& key, const int digit_idx) restrict(amp)
+        {
+            const int offset = digit_idx * digit_width;
+            const int word_idx = offset / 32;
+            const int shift = offset % 32;
+
+            unsigned int bits = radix_key_traits<T>::word(key, word_idx) >> shift;
+            if (((shift + digit_width) > 32) && ((word_idx + 1) < radix_key_traits<T>::word_count))
+            {
+                bits |= radix_key_traits<T>::word(key, word_idx + 1) << (32 - shift);
+            }
+            return bits & ((1 << digit_width) - 1);
         }
 
-        template <typename T, int key_bit_width, int tile_size>
-        void radix_sort_tile_by_key(T* const tile_data, concurrency::tiled_index<tile_size> tidx, const int key_idx) restrict(amp)
+        // Per digit counters of radix_rank_tile, each word packs the 16 bit counters of two digits.
+        template <int word_count>
+        struct radix_rank_counters
         {
-            static_assert((tile_size <= 256), "The tile size must be less than or equal to 256.");
-            static_assert((key_bit_width >=1), "The radix bit width must be greater than or equal to one.");
-            static_assert((key_bit_width <= 2), "The radix bit width must be less than or equal to two.");
+            unsigned int words[word_count];
+        };
 
-            const unsigned bin_count = 1 << key_bit_width;
-            const int idx = tidx.local[0];
+        template <int word_count>
+        struct radix_rank_counters_plus
+        {
+            radix_rank_counters<word_count> operator()(const radix_rank_counters<word_count>& a, const radix_rank_counters<word_count>& b) const restrict(cpu, amp)
+            {
+                radix_rank_counters<word_count> sum;
+                for (int i = 0; i < word_count; ++i)
+                {
+                    sum.words[i] = a.words[i] + b.words[i];
+                }
+                return sum;
+            }
+        };
 
-            // Increment histogram bins for each element.
+        // Stable ranking of a tile by digit. Returns where the element of this thread goes when the tile is sorted by digit
+        // and sets digit_start to where the elements with its digit start.
+        //
+        // Each thread flags its digit and an exclusive scan_tile_tree of the flags counts the elements with the same digit
+        // earlier in the tile. The flags of several digits are packed into one scan element, so a single scan ranks small
+        // digits and wide digits need a scan per group of digits. A last scan of the digit totals gives the digit starts.
+        template <int key_bit_width, int tile_size>
+        int radix_rank_tile(const unsigned int digit, concurrency::tiled_index<tile_size> tidx, unsigned int& digit_start) restrict(amp)
+        {
+            static const int bin_count = 1 << key_bit_width;
+            static const int max_word_count = (4096 / tile_size > 0) ? (4096 / tile_size) : 1;
+            static const int word_count = ((bin_count + 1) / 2 < max_word_count) ? ((bin_count + 1) / 2) : max_word_count;
+            static const int digits_per_scan = word_count * 2;
+            static const int scan_count = (bin_count + digits_per_scan - 1) / digits_per_scan;
+            static const int totals_per_thread = (bin_count + tile_size - 1) / tile_size;
+            static_assert((tile_size < 65536), "The tile size must fit in the 16 bit digit counters.");
 
-            tile_static unsigned tile_radix_values[tile_size];
-            int radix_value = _details::radix_key_value<T, key_bit_width>(tile_data[idx], key_idx);  // TODO: Get rid of this and recalculate?
-            tile_radix_values[idx] = pack_byte(1, radix_value);
+            typedef radix_rank_counters<word_count> counters;
 
-            tidx.barrier.wait_with_tile_static_memory_fence();
+            tile_static counters tile_counters[tile_size];
+            tile_static unsigned int tile_totals[bin_count];
+            tile_static unsigned int tile_sums[tile_size];
+
+            const int idx = tidx.local[0];
+            const int digit_scan = int(digit) / digits_per_scan;
+            const int digit_word = (int(digit) % digits_per_scan) / 2;
+            const int digit_shift = (int(digit) % 2) * 16;
 
-            tile_static unsigned histogram_bins_scan[bin_count];
-            if (idx == 0)
+            counters zero;
+            for (int i = 0; i < word_count; ++i)
             {
-                // Calculate histogram of radix values.
+                zero.words[i] = 0;
+            }
 
-                unsigned histogram_bins = 0;
-                for (int i = 0; i < tile_size; ++i)
+            unsigned int rank = 0;
+            for (int s = 0; s < scan_count; ++s)
+            {
+                counters flags = zero;
+                if (s == digit_scan)
                 {
-                    histogram_bins += tile_radix_values[i];
+                    flags.words[digit_word] = 1u << digit_shift;
                 }
+                tile_counters[idx] = flags;
 
-                // Scan to get offsets for each histogram bin.
+                const counters prefix = _details::scan_tile_tree<tile_size, scan_mode::exclusive>(tile_counters, tidx, radix_rank_counters_plus<word_count>(), zero);
+                if (s == digit_scan)
+                {
+                    rank = (prefix.words[digit_word] >> digit_shift) & 0xFFFF;
+                }
 
-                histogram_bins_scan[0] = 0;
-                histogram_bins_scan[1] = unpack_byte<0>(histogram_bins);
-                if (key_bit_width > 1)
+                // The last thread has the exclusive prefix of the whole tile, adding its own flags gives the digit totals.
+                if (idx == (tile_size - 1))
                 {
-                    histogram_bins_scan[2] = unpack_byte<1>(histogram_bins) + histogram_bins_scan[1];
-                    histogram_bins_scan[3] = unpack_byte<2>(histogram_bins) + histogram_bins_scan[2];
+                    for (int d = 0; (d < digits_per_scan) && ((s * digits_per_scan + d) < bin_count); ++d)
+                    {
+                        tile_totals[s * digits_per_scan + d] = ((prefix.words[d / 2] + flags.words[d / 2]) >> ((d % 2) * 16)) & 0xFFFF;
+                    }
                 }
             }
-            _details::scan_tile<tile_size, amp_algorithms::scan_mode::exclusive>(tile_radix_values, tidx, amp_algorithms::plus<T>());
+            tidx.barrier.wait_with_tile_static_memory_fence();
 
-            // Shuffle data into sorted order.
+            // Each thread scans a few digit totals and scan_tile scans their sums, so there can be more digits than threads.
+            unsigned int sum = 0;
+            for (int b = idx * totals_per_thread; (b < (idx + 1) * totals_per_thread) && (b < bin_count); ++b)
+            {
+                sum += tile_totals[b];
+            }
+            tile_sums[idx] = sum;
 
-            T tmp = tile_data[idx];
+            unsigned int prefix = _details::scan_tile_tree<tile_size, scan_mode::exclusive>(tile_sums, tidx, amp_algorithms::plus<unsigned int>(), 0u);
+            for (int b = idx * totals_per_thread; (b < (idx + 1) * totals_per_thread) && (b < bin_count); ++b)
+            {
+                const unsigned int count = tile_totals[b];
+                tile_totals[b] = prefix;
+                prefix += count;
+            }
             tidx.barrier.wait_with_tile_static_memory_fence();
-            int offset = histogram_bins_scan[radix_value] + unpack_byte(tile_radix_values[idx], radix_value);
-            tile_data[offset] = tmp;
+
+            digit_start = tile_totals[digit];
+            return int(digit_start + rank);
         }
 
-        template <typename T, int key_bit_width, int tile_size>
-        void radix_sort_by_key(const concurrency::array_view<T>& input_view, concurrency::array_view<T>& output_view, const int key_idx)
+        // Values moved with the keys by the radix sort, the element of the pass input at src moves to dest in the pass output.
+        // The input and output are swapped after each pass.
+        struct radix_sort_no_values
         {
-            static const unsigned type_width = sizeof(T) * 8;
-            static_assert((type_width % key_bit_width == 0), "The sort key width must be divisible by the type width.");
-            static_assert((key_bit_width % 2 == 0), "The key bit width must be divisible by two.");
+            void scatter(const int, const int) const restrict(cpu, amp)
+            {
+            }
+
+            void discard_output()
+            {
+            }
+
+            void swap()
+            {
+            }
+        };
 
-            static const unsigned bin_count = 1 << key_bit_width;
-            static const T bin_mask = bin_count - 1;
-            static const int elements_per_thread = 1;          // TODO: Doesn't have to be a constant?
+        template <typename T>
+        struct radix_sort_values
+        {
+            radix_sort_values(const concurrency::array_view<T>& input, const concurrency::array_view<T>& output) :
+                input_view(input),
+                output_view(output)
+            {
+            }
 
-            // histogram all elements in a block
-            concurrency::array<unsigned> histogram_bins(bin_count);  // TODO: Need to add accelerator view.
-            concurrency::array_view<unsigned> histogram_bins_vw(histogram_bins);
+            void scatter(const int dest, const int src) const restrict(cpu, amp)
+            {
+                output_view[dest] = input_view[src];
+            }
 
-            concurrency::tiled_extent<tile_size> compute_domain = input_view.get_extent().tile<tile_size>().pad();
+            void discard_output()
+            {
+                output_view.discard_data();
+            }
 
-            concurrency::parallel_for_each(compute_domain, [=, &histogram_bins](concurrency::tiled_index<tile_size> tidx) restrict(amp)
+            void swap()
+            {
+                std::swap(input_view, output_view);
+            }
+
+            concurrency::array_view<T> input_view;
+            concurrency::array_view<T> output_view;
+        };
+
+        // One pass of the radix sort, a stable sort of input_view by its digit_idx'th digit into output_view.
+        //
+        // The first kernel counts the digits in each tile. The counts are stored digit major, so an exclusive scan of
+        // them gives the output offset of the elements of each digit in each tile. The second kernel ranks each tile by
+        // the digit and scatters the elements to these offsets, so the elements of a tile with the same digit are written
+        // to consecutive locations.
+        template <typename T, int digit_width, int tile_size, typename Values>
+        void radix_sort_pass(const concurrency::accelerator_view& accl_view, const concurrency::array_view<T>& input_view, const concurrency::array_view<T>& output_view,
+            const Values& values, const concurrency::array_view<unsigned int>& tile_offsets_view, const int digit_idx)
+        {
+            static const int bin_count = 1 << digit_width;
+
+            const int size = input_view.extent[0];
+            const int tile_count = tile_offsets_view.extent[0] / bin_count;
+            const concurrency::tiled_extent<tile_size> compute_domain = input_view.extent.template tile<tile_size>().pad();
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
             {
-                // Each thread has its own histogram
-                tile_static unsigned tile_bins[tile_size][bin_count];
-                tile_static T tile_data[tile_size];
                 const int gidx = tidx.global[0];
                 const int idx = tidx.local[0];
-                const int start_elem = idx * elements_per_thread;
+                tile_static unsigned int tile_bins[bin_count];
 
-                // One thread initializes the global histogram bins.
-                if (gidx == 0)
+                for (int b = idx; b < bin_count; b += tile_size)
                 {
-                    //initialize_bins(histogram_bins_vw[b], bin_count);
+                    tile_bins[b] = 0;
                 }
-                initialize_bins(tile_bins[idx], bin_count);
+                tidx.barrier.wait_with_tile_static_memory_fence();
 
-                // Increment bins for each element.
-                if (gidx < input_view.extent[0])
+                if (gidx < size)
                 {
-                    tile_bins[idx][_details::radix_key_value<T, key_bit_width>(input_view[gidx], key_idx)]++;
+                    concurrency::atomic_fetch_inc(&tile_bins[radix_key_digit<T, digit_width>(input_view[gidx], digit_idx)]);
                 }
                 tidx.barrier.wait_with_tile_static_memory_fence();
 
-                // TODO: This could be more efficient. Don't do it all on one thread.
-                if (idx == 0)
+                for (int b = idx; b < bin_count; b += tile_size)
+                {
+                    tile_offsets_view[b * tile_count + tidx.tile[0]] = tile_bins[b];
+                }
+            });
+
+            concurrency::array_view<unsigned int> offsets_view = tile_offsets_view;
+            _details::scan<_details::scan_default_tile_size, scan_mode::exclusive>(accl_view, offsets_view, offsets_view, amp_algorithms::plus<unsigned int>(), 0u);
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
+            {
+                const int gidx = tidx.global[0];
+                const bool is_valid = (gidx < size);
+                const T key = is_valid ? input_view[gidx] : T();
+
+                // Padding elements get the largest digit so they rank after all the elements of the tile.
+                const unsigned int digit = is_valid ? radix_key_digit<T, digit_width>(key, digit_idx) : (bin_count - 1);
+                unsigned int digit_start;
+                const int rank = radix_rank_tile<digit_width, tile_size>(digit, tidx, digit_start);
+
+                if (is_valid)
                 {
-                    // Thread zero merges local histograms.
-                    for (int i = 1; i < tile_size; ++i)
+                    const int dest = int(tile_offsets_view[digit * tile_count + tidx.tile[0]] + (rank - digit_start));
+                    output_view[dest] = key;
+                    values.scatter(dest, gidx);
+                }
+            });
+        }
+
+        // Sorts the keys and the values, returns true if the values were left in their temporary buffer. The keys are
+        // always copied back to keys_view.
+        template <typename TKey, int digit_width, int tile_size, typename Values>
+        bool radix_sort_passes(const concurrency::accelerator_view& accl_view, concurrency::array_view<TKey>& keys_view, Values& values)
+        {
+            static_assert((digit_width >= 1) && (digit_width <= 8), "The digit width must be between one and eight bits.");
+            static_assert((tile_size <= 1024), "The tile size must be less than or equal to 1024.");
+
+            static const int pass_count = (radix_key_traits<TKey>::word_count * 32 + digit_width - 1) / digit_width;
+
+            const int size = keys_view.extent[0];
+            if (size <= 1)
+            {
+                return false;
+            }
+            const int tile_count = (size + tile_size - 1) / tile_size;
+
+            // Each pass sorts from one buffer to the other.
+            scratch_buffer<TKey> tmp(accl_view, size);
+            scratch_buffer<unsigned int> tile_offsets(accl_view, (1 << digit_width) * tile_count);
+            concurrency::array_view<TKey> src_view = keys_view;
+            concurrency::array_view<TKey> dest_view = tmp.view();
+
+            for (int digit_idx = 0; digit_idx < pass_count; ++digit_idx)
+            {
+                dest_view.discard_data();
+                values.discard_output();
+                radix_sort_pass<TKey, digit_width, tile_size>(accl_view, src_view, dest_view, values, tile_offsets.view(), digit_idx);
+                std::swap(src_view, dest_view);
+                values.swap();
+            }
+
+            if ((pass_count % 2) != 0)
+            {
+                concurrency::copy(src_view, keys_view);
+                return true;
+            }
+            return false;
+        }
+
+        template <typename T, int digit_width, int tile_size>
+        void radix_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<T>& input_view)
+        {
+            radix_sort_no_values values;
+            radix_sort_passes<T, digit_width, tile_size>(accl_view, input_view, values);
+        }
+
+        template <typename TKey, typename TValue, int digit_width, int tile_size>
+        void radix_sort_by_key(const concurrency::accelerator_view& accl_view, concurrency::array_view<TKey>& keys_view, concurrency::array_view<TValue>& values_view)
+        {
+            scratch_buffer<TValue> tmp(accl_view, values_view.extent[0]);
+            radix_sort_values<TValue> values(values_view, tmp.view());
+            if (radix_sort_passes<TKey, digit_width, tile_size>(accl_view, keys_view, values))
+            {
+                concurrency::copy(values.input_view, values_view);
+            }
+        }
+
+        // Radix select, finds the element of rank k in radix order, one 8 bit digit at a time from the most significant.
+        // Each pass builds a histogram of the digit over the elements whose higher digits match those found so far,
+        // and the bin containing rank k gives the next digit. The key words of the element, and the number of elements
+        // before it and equal to it, are known after word_count * 4 passes that each read the input once.
+
+        struct radix_selection
+        {
+            unsigned int key_words[2];
+            int less_count;
+            int equal_count;
+        };
+
+        static const int radix_select_tile_size = 256;
+        static const int radix_select_max_tiles = 512;
+
+        // Compares the key words of key with those of the selected element.
+        template <typename T>
+        inline int radix_select_compare(const T& key, const unsigned int key_low, const unsigned int key_high) restrict(amp)
+        {
+            const unsigned int high = (radix_key_traits<T>::word_count > 1) ? radix_key_traits<T>::word(key, radix_key_traits<T>::word_count - 1) : 0;
+            const unsigned int low = radix_key_traits<T>::word(key, 0);
+            if (high != key_high)
+            {
+                return (high < key_high) ? -1 : 1;
+            }
+            return (low == key_low) ? 0 : ((low < key_low) ? -1 : 1);
+        }
+
+        template <typename T, typename InputIndexableView>
+        radix_selection radix_select(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, int k)
+        {
+            static const int digit_width = 8;
+            static const int bin_count = 1 << digit_width;
+            static const int word_count = radix_key_traits<T>::word_count;
+            static const int pass_count = word_count * 32 / digit_width;
+            static const int tile_size = radix_select_tile_size;
+            static_assert((tile_size == bin_count), "The tile size must equal the number of digit values.");
+
+            const int size = input_view.extent[0];
+            const int tile_count = (size < (radix_select_max_tiles * tile_size)) ? ((size + tile_size - 1) / tile_size) : radix_select_max_tiles;
+            const int stride = tile_count * tile_size;
+            const concurrency::tiled_extent<tile_size> compute_domain = concurrency::extent<1>(stride).tile<tile_size>();
+
+            scratch_buffer<unsigned int> histogram(accl_view, bin_count);
+            concurrency::array_view<unsigned int> histogram_view = histogram.view();
+            std::vector<unsigned int> counts(bin_count);
+
+            radix_selection selection = { { 0, 0 }, 0, size };
+            unsigned int key_masks[2] = { 0, 0 };
+            for (int digit_idx = pass_count - 1; digit_idx >= 0; --digit_idx)
+            {
+                const unsigned int prefix_low = selection.key_words[0];
+                const unsigned int prefix_high = selection.key_words[1];
+                const unsigned int mask_low = key_masks[0];
+                const unsigned int mask_high = key_masks[1];
+
+                _details::parallel_for_each(accl_view, concurrency::extent<1>(bin_count), [=](concurrency::index<1> idx) restrict(amp)
+                {
+                    histogram_view[idx] = 0;
+                });
+
+                // Each tile builds its histogram in tile memory and adds it to the global one.
+                _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
+                {
+                    tile_static unsigned int tile_bins[bin_count];
+                    const int idx = tidx.local[0];
+                    tile_bins[idx] = 0;
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+
+                    for (int i = tidx.global[0]; i < size; i += stride)
                     {
-                        merge_bins(tile_bins[0], tile_bins[i], bin_count);
+                        const T key = input_view[i];
+                        const bool is_candidate = ((radix_key_traits<T>::word(key, 0) & mask_low) == prefix_low) &&
+                            ((word_count == 1) || ((radix_key_traits<T>::word(key, word_count - 1) & mask_high) == prefix_high));
+                        if (is_candidate)
+                        {
+                            concurrency::atomic_fetch_inc(&tile_bins[radix_key_digit<T, digit_width>(key, digit_idx)]);
+                        }
                     }
+                    tidx.barrier.wait_with_tile_static_memory_fence();
 
-                    // TODO: This isn't smart either but it'll get things working.
-
-                    // Thread zero copies and merges data with global histogram.
-                    for (int b = 0; b < bin_count; ++b)
+                    if (tile_bins[idx] != 0)
                     {
-                        concurrency::atomic_fetch_add(&histogram_bins_vw(b), tile_bins[0][b]);
+                        concurrency::atomic_fetch_add(&histogram_view[idx], tile_bins[idx]);
                     }
+                });
 
-                    //_details::scan_tile<tile_size, amp_algorithms::scan_mode::exclusive>(tile_bins[0], tidx, amp_algorithms::plus<T>());
+                concurrency::copy(histogram_view, counts.begin());
+                unsigned int digit = 0;
+                while (counts[digit] <= static_cast<unsigned int>(k))
+                {
+                    k -= int(counts[digit]);
+                    selection.less_count += int(counts[digit]);
+                    ++digit;
                 }
+                selection.equal_count = int(counts[digit]);
+
+                const int word_idx = (digit_idx * digit_width) / 32;
+                const int shift = (digit_idx * digit_width) % 32;
+                selection.key_words[word_idx] |= digit << shift;
+                key_masks[word_idx] |= static_cast<unsigned int>(bin_count - 1) << shift;
+            }
+            return selection;
+        }
 
-                // Sort tiles by 
-                tidx.barrier.wait();
-                for (int i = 0; i < (key_bit_width / 2); ++i)
+        // Writes the elements of input_view to output_view partitioned around the selected element, those before it,
+        // those equal to it and those after it in radix order, or the reverse if descending. Elements are not kept in
+        // order within a partition, and any that fall beyond the end of output_view are dropped.
+        template <typename T, typename InputIndexableView>
+        void radix_select_partition(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, const radix_selection& selection,
+            const bool descending, const concurrency::array_view<T>& output_view)
+        {
+            static const int tile_size = radix_select_tile_size;
+
+            const int size = input_view.extent[0];
+            const int output_size = output_view.extent[0];
+            const int greater_count = size - selection.less_count - selection.equal_count;
+            const unsigned int key_low = selection.key_words[0];
+            const unsigned int key_high = selection.key_words[1];
+
+            // Each tile reserves space for its elements of each partition with a single atomic per partition.
+            const unsigned int partition_starts[3] = { 0,
+                static_cast<unsigned int>(descending ? greater_count : selection.less_count),
+                static_cast<unsigned int>(descending ? (greater_count + selection.equal_count) : (selection.less_count + selection.equal_count)) };
+            scratch_buffer<unsigned int> partition_offsets(accl_view, 3);
+            concurrency::array_view<unsigned int> partition_offsets_view = partition_offsets.view();
+            concurrency::copy(std::begin(partition_starts), std::end(partition_starts), partition_offsets_view);
+
+            const concurrency::tiled_extent<tile_size> compute_domain = concurrency::extent<1>(size).tile<tile_size>().pad();
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
+            {
+                tile_static unsigned int tile_counts[3];
+                tile_static unsigned int tile_starts[3];
+                const int idx = tidx.local[0];
+                const int gidx = tidx.global[0];
+                if (idx < 3)
                 {
-                    radix_sort_tile_by_key<T, 2, tile_size>(tile_data, tidx, i);
+                    tile_counts[idx] = 0;
                 }
+                tidx.barrier.wait_with_tile_static_memory_fence();
 
-                // Shuffle data into sorted order.
+                const bool is_valid = (gidx < size);
+                const T key = is_valid ? input_view[gidx] : T();
+                int partition = 0;
+                unsigned int rank = 0;
+                if (is_valid)
+                {
+                    partition = radix_select_compare(key, key_low, key_high) + 1;
+                    partition = descending ? (2 - partition) : partition;
+                    rank = concurrency::atomic_fetch_inc(&tile_counts[partition]);
+                }
+                tidx.barrier.wait_with_tile_static_memory_fence();
 
-                const T tmp = tile_data[idx];
+                if (idx < 3)
+                {
+                    tile_starts[idx] = concurrency::atomic_fetch_add(&partition_offsets_view[idx], tile_counts[idx]);
+                }
                 tidx.barrier.wait_with_tile_static_memory_fence();
-                //int offset = idx - tile_bins[tmp];
-                //input_view[offset] = tmp;
+
+                const int dest = int(tile_starts[partition] + rank);
+                if (is_valid && (dest < output_size))
+                {
+                    output_view[dest] = key;
+                }
             });
+        }
 
-            amp_algorithms::scan<tile_size, scan_mode::exclusive>(histogram_bins_vw, histogram_bins_vw, amp_algorithms::plus<unsigned int>());
+        // Stable sort of the elements of a tile by their key_idx'th digit of key_bit_width bits.
+        template <typename T, int key_bit_width, int tile_size>
+        void radix_sort_tile_by_key(T* const tile_data, concurrency::tiled_index<tile_size> tidx, const int key_idx) restrict(amp)
+        {
+            static_assert((tile_size <= 1024), "The tile size must be less than or equal to 1024.");
+            static_assert((key_bit_width >= 1), "The radix bit width must be greater than or equal to one.");
+            static_assert((key_bit_width <= 8), "The radix bit width must be less than or equal to eight.");
 
-            // Reorder the elements based on the offsets.
-            concurrency::parallel_for_each(compute_domain, [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
-            {
-                const int gidx = tidx.global[0];
-                const int idx = tidx.local[0];
+            const int idx = tidx.local[0];
+            const T value = tile_data[idx];
 
-                // TODO: Will this work if the input and output views overlap or are the same?
-                //const int d = tile_bins[] + /* local offset +  */ histogram_bins_vw[tidx.tile];
-                //output_view[gidx] = input_view[d];
-            });
+            unsigned int digit_start;
+            const int rank = radix_rank_tile<key_bit_width, tile_size>(_details::radix_key_value<T, key_bit_width>(value, key_idx), tidx, digit_start);
+
+            // All the threads have read their value before ranking, so the values can be written in place.
+            tile_data[rank] = value;
+            tidx.barrier.wait_with_tile_static_memory_fence();
         }
     }
 
-    // TODO: NOT IMPLEMENTED radix_sort
-    inline void radix_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<int>& input_view)
+    // Sorts the keys into ascending order with a least significant digit radix sort, digit_width bits at a time. Wider
+    // digits need fewer passes over the keys but each pass counts more digit values. The sort is stable and supports
+    // int, unsigned int, float, int64_key and uint64_key keys.
+    template <int digit_width, typename T>
+    void radix_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<T>& input_view)
     {
-        static const int bin_width = 4;
         static const int tile_size = 256;
-        ::amp_algorithms::_details::radix_sort<int, bin_width, tile_size>(accl_view, input_view);
+        ::amp_algorithms::_details::radix_sort<T, digit_width, tile_size>(accl_view, input_view);
+    }
+
+    template <int digit_width, typename T>
+    void radix_sort(concurrency::array_view<T>& input_view)
+    {
+        radix_sort<digit_width>(_details::auto_select_target(), input_view);
+    }
+
+    template <typename T>
+    void radix_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<T>& input_view)
+    {
+        static const int digit_width = 4;
+        radix_sort<digit_width>(accl_view, input_view);
     }
 
-    // TODO: NOT IMPLEMENTED radix_sort
-    inline void radix_sort(concurrency::array_view<int>& input_view)
+    template <typename T>
+    void radix_sort(concurrency::array_view<T>& input_view)
     {
         radix_sort(_details::auto_select_target(), input_view);
     }
 
-    /*
-    inline void radix_sort(concurrency::array_view<int>& input_view, const unsigned int digit_width)
+    // Sorts the keys like radix_sort and moves each value to the position of its key. The values may be of any type that
+    // C++ AMP can store in an array_view. Equal keys keep the order of their values.
+    template <int digit_width, typename TKey, typename TValue>
+    void radix_sort_by_key(const concurrency::accelerator_view& accl_view, concurrency::array_view<TKey>& keys_view, concurrency::array_view<TValue>& values_view)
     {
-    ::amp_algorithms::_details::radix_sort<int, 4>(_details::auto_select_target(), input_view);
+        static const int tile_size = 256;
+        if (keys_view.extent != values_view.extent)
+        {
+            throw concurrency::runtime_exception("The keys and values must be the same size.", E_INVALIDARG);
+        }
+        ::amp_algorithms::_details::radix_sort_by_key<TKey, TValue, digit_width, tile_size>(accl_view, keys_view, values_view);
+    }
+
+    template <int digit_width, typename TKey, typename TValue>
+    void radix_sort_by_key(concurrency::array_view<TKey>& keys_view, concurrency::array_view<TValue>& values_view)
+    {
+        radix_sort_by_key<digit_width>(_details::auto_select_target(), keys_view, values_view);
     }
 
-    inline void radix_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<unsigned int>& input_view, const unsigned int digit_width)
+    template <typename TKey, typename TValue>
+    void radix_sort_by_key(const concurrency::accelerator_view& accl_view, concurrency::array_view<TKey>& keys_view, concurrency::array_view<TValue>& values_view)
     {
-    ::amp_algorithms::_details::radix_sort<unsigned int, 4>(accl_view, input_view);
+        static const int digit_width = 4;
+        radix_sort_by_key<digit_width>(accl_view, keys_view, values_view);
     }
 
-    inline void radix_sort(concurrency::array_view<unsigned int>& input_view)
+    template <typename TKey, typename TValue>
+    void radix_sort_by_key(concurrency::array_view<TKey>& keys_view, concurrency::array_view<TValue>& values_view)
     {
-    ::amp_algorithms::_details::radix_sort<unsigned int, 4>(_details::auto_select_target(), input_view);
+        radix_sort_by_key(_details::auto_select_target(), keys_view, values_view);
     }
-    */
 
     //----------------------------------------------------------------------------
     // reduce
@@ -659,8 +1157,7 @@ namespace amp_algorithms
     typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type
         reduce(const concurrency::accelerator_view &accl_view, const InputIndexableView &input_view, const BinaryFunction &binary_op)
     {
-        const int tile_size = 512;
-        return _details::reduce<tile_size, 10000, InputIndexableView, BinaryFunction>(accl_view, input_view, binary_op);
+        return _details::reduce<_details::reduce_tile_size, _details::reduce_max_tiles, InputIndexableView, BinaryFunction>(accl_view, input_view, binary_op);
     }
 
     template <typename InputIndexableView, typename BinaryFunction>
@@ -670,51 +1167,245 @@ namespace amp_algorithms
         return reduce(_details::auto_select_target(), input_view, binary_op);
     }
 
+    // Asynchronous reduction for chaining reductions without waiting for each result on the host.
+    template <typename InputIndexableView, typename BinaryFunction>
+    std::future<typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type>
+        reduce_async(const concurrency::accelerator_view &accl_view, const InputIndexableView &input_view, const BinaryFunction &binary_op)
+    {
+        return _details::reduce_async<_details::reduce_tile_size, _details::reduce_max_tiles, InputIndexableView, BinaryFunction>(accl_view, input_view, binary_op);
+    }
+
+    template <typename InputIndexableView, typename BinaryFunction>
+    std::future<typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type>
+        reduce_async(const InputIndexableView &input_view, const BinaryFunction &binary_op)
+    {
+        return reduce_async(_details::auto_select_target(), input_view, binary_op);
+    }
+
+    //----------------------------------------------------------------------------
+    // scratch buffers
+    //----------------------------------------------------------------------------
+
+    // The algorithms reuse their temporary buffers between calls. Frees the buffers that are not currently in use.
+    inline void release_scratch_buffers()
+    {
+        _details::scratch_pool::instance().clear();
+    }
+
     //----------------------------------------------------------------------------
     // scan - C++ AMP implementation
     //----------------------------------------------------------------------------
     //
-    // Scan implementation using the same algorithm described here and used by the CUDPP library.
+    // Tiles are scanned using the same algorithm described here and used by the CUDPP library.
     //
     // https://research.nvidia.com/sites/default/files/publications/nvr-2008-003.pdf
     //
+    // The tiles are combined in a single pass using decoupled look-back, see _details::scan_single_pass. Define
+    // AMP_ALGORITHMS_SCAN_MULTI_PASS to use the original three pass implementation. Inputs of up to
+    // AMP_ALGORITHMS_SCAN_SINGLE_TILE_THRESHOLD elements are scanned by a single tile in one kernel.
+    //
     // For a full overview of various scan implementations see:
     //
     // https://sites.google.com/site/duanemerrill/ScanTR2.pdf
     //
-    // TODO: There may be some better scan implementations that are described in the second reference. Investigate.
-    // TODO: Scan only supports Rank of 1.
-    // TODO: Scan does not support segmented scan or forwards/backwards.
-    // TODO: IMPORTANT! Scan uses information about the warp size. Consider using an algorithm that does not need to use this.
+    // Scan only supports Rank of 1, use multi_scan_exclusive and multi_scan_inclusive to scan the rows of a Rank 2 view.
+    //
+    // By default tiles are scanned warp synchronously, which relies on the warp size and on the threads of a warp executing
+    // in lock step. Define AMP_ALGORITHMS_SCAN_TILE_TREE to scan tiles with a tree that only uses tile barriers, which
+    // is correct on any accelerator, see _details::scan_tile_tree.
+
+    // The identity of op is taken from operator_identity<_BinaryFunc> unless it is passed explicitly. op must be
+    // associative, it need not be commutative. A backward scan reads and writes the elements in reverse order, so for
+    // an inclusive scan output[i] = op(input[i], op(input[i + 1], ... input[n - 1])).
+
+    template <int TileSize, scan_mode _Mode, scan_direction _Direction = scan_direction::forward, typename _BinaryFunc, typename InputIndexableView>
+    inline void scan(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view, const _BinaryFunc& op,
+        const typename InputIndexableView::value_type& identity)
+    {
+        _details::scan<TileSize, _Mode, _Direction>(accl_view, input_view, output_view, op, identity);
+    }
 
-    template <int TileSize, scan_mode _Mode, typename _BinaryFunc, typename InputIndexableView>
+    template <int TileSize, scan_mode _Mode, scan_direction _Direction = scan_direction::forward, typename _BinaryFunc, typename InputIndexableView>
+    inline void scan(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view, const _BinaryFunc& op)
+    {
+        _details::scan<TileSize, _Mode, _Direction>(accl_view, input_view, output_view, op, operator_identity<_BinaryFunc>::value());
+    }
+
+    template <int TileSize, scan_mode _Mode, scan_direction _Direction = scan_direction::forward, typename _BinaryFunc, typename InputIndexableView>
     inline void scan(const InputIndexableView& input_view, InputIndexableView& output_view, const _BinaryFunc& op)
     {
-        _details::scan<TileSize, _Mode, _BinaryFunc>(_details::auto_select_target(), input_view, output_view, op);
+        _details::scan<TileSize, _Mode, _Direction>(_details::auto_select_target(), input_view, output_view, op, operator_identity<_BinaryFunc>::value());
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void scan_exclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, const _BinaryFunc& op)
+    {
+        scan<_details::scan_default_tile_size, amp_algorithms::scan_mode::exclusive>(accl_view, input_view, output_view, op);
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void scan_exclusive(const IndexableView& input_view, IndexableView& output_view, const _BinaryFunc& op)
+    {
+        scan<_details::scan_default_tile_size, amp_algorithms::scan_mode::exclusive>(_details::auto_select_target(), input_view, output_view, op);
     }
 
     template <typename IndexableView>
     void scan_exclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view)
     {
-        scan<_details::scan_default_tile_size, amp_algorithms::scan_mode::exclusive>(accl_view, input_view, output_view, amp_algorithms::plus<IndexableView::value_type>());
+        scan_exclusive(accl_view, input_view, output_view, amp_algorithms::plus<typename IndexableView::value_type>());
     }
 
     template <typename IndexableView>
     void scan_exclusive(const IndexableView& input_view, IndexableView& output_view)
     {
-        scan<_details::scan_default_tile_size, amp_algorithms::scan_mode::exclusive>(_details::auto_select_target(), input_view, output_view, amp_algorithms::plus<typename IndexableView::value_type>());
+        scan_exclusive(_details::auto_select_target(), input_view, output_view, amp_algorithms::plus<typename IndexableView::value_type>());
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void scan_inclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, const _BinaryFunc& op)
+    {
+        scan<_details::scan_default_tile_size, amp_algorithms::scan_mode::inclusive>(accl_view, input_view, output_view, op);
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void scan_inclusive(const IndexableView& input_view, IndexableView& output_view, const _BinaryFunc& op)
+    {
+        scan<_details::scan_default_tile_size, amp_algorithms::scan_mode::inclusive>(_details::auto_select_target(), input_view, output_view, op);
     }
 
     template <typename IndexableView>
     void scan_inclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view)
     {
-        scan<_details::scan_default_tile_size, amp_algorithms::scan_mode::inclusive>(accl_view, input_view, output_view, amp_algorithms::plus<IndexableView::value_type>());
+        scan_inclusive(accl_view, input_view, output_view, amp_algorithms::plus<typename IndexableView::value_type>());
     }
 
     template <typename IndexableView>
     void scan_inclusive(const IndexableView& input_view, IndexableView& output_view)
     {
-        scan<_details::scan_default_tile_size, amp_algorithms::scan_mode::inclusive>(_details::auto_select_target(), input_view, output_view, amp_algorithms::plus<typename IndexableView::value_type>());
+        scan_inclusive(_details::auto_select_target(), input_view, output_view, amp_algorithms::plus<typename IndexableView::value_type>());
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void scan_exclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, scan_direction direction, const _BinaryFunc& op)
+    {
+        if (direction == scan_direction::forward)
+            scan<_details::scan_default_tile_size, scan_mode::exclusive, scan_direction::forward>(accl_view, input_view, output_view, op);
+        else
+            scan<_details::scan_default_tile_size, scan_mode::exclusive, scan_direction::backward>(accl_view, input_view, output_view, op);
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void scan_exclusive(const IndexableView& input_view, IndexableView& output_view, scan_direction direction, const _BinaryFunc& op)
+    {
+        scan_exclusive(_details::auto_select_target(), input_view, output_view, direction, op);
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void scan_inclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, scan_direction direction, const _BinaryFunc& op)
+    {
+        if (direction == scan_direction::forward)
+            scan<_details::scan_default_tile_size, scan_mode::inclusive, scan_direction::forward>(accl_view, input_view, output_view, op);
+        else
+            scan<_details::scan_default_tile_size, scan_mode::inclusive, scan_direction::backward>(accl_view, input_view, output_view, op);
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void scan_inclusive(const IndexableView& input_view, IndexableView& output_view, scan_direction direction, const _BinaryFunc& op)
+    {
+        scan_inclusive(_details::auto_select_target(), input_view, output_view, direction, op);
+    }
+
+    //----------------------------------------------------------------------------
+    // segmented_scan_exclusive & segmented_scan_inclusive
+    //----------------------------------------------------------------------------
+    //
+    // Scans each segment of the input independently in a single scan. Segments are given either by head flags, where
+    // a non-zero flag marks the first element of a segment, or by the offsets of the first element of each segment.
+    // The first element always starts a segment. op must be associative.
+
+    template <typename IndexableView, typename FlagIndexableView, typename _BinaryFunc>
+    void segmented_scan_exclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, const FlagIndexableView& flags_view, const _BinaryFunc& op)
+    {
+        _details::segmented_scan<_details::scan_default_tile_size, scan_mode::exclusive>(accl_view, input_view, output_view, flags_view, op, operator_identity<_BinaryFunc>::value());
+    }
+
+    template <typename IndexableView, typename FlagIndexableView, typename _BinaryFunc>
+    void segmented_scan_exclusive(const IndexableView& input_view, IndexableView& output_view, const FlagIndexableView& flags_view, const _BinaryFunc& op)
+    {
+        segmented_scan_exclusive(_details::auto_select_target(), input_view, output_view, flags_view, op);
+    }
+
+    template <typename IndexableView, typename FlagIndexableView, typename _BinaryFunc>
+    void segmented_scan_inclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, const FlagIndexableView& flags_view, const _BinaryFunc& op)
+    {
+        _details::segmented_scan<_details::scan_default_tile_size, scan_mode::inclusive>(accl_view, input_view, output_view, flags_view, op, operator_identity<_BinaryFunc>::value());
+    }
+
+    template <typename IndexableView, typename FlagIndexableView, typename _BinaryFunc>
+    void segmented_scan_inclusive(const IndexableView& input_view, IndexableView& output_view, const FlagIndexableView& flags_view, const _BinaryFunc& op)
+    {
+        segmented_scan_inclusive(_details::auto_select_target(), input_view, output_view, flags_view, op);
+    }
+
+    template <typename IndexableView, typename OffsetIndexableView, typename _BinaryFunc>
+    void segmented_scan_exclusive_by_offsets(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, const OffsetIndexableView& offsets_view, const _BinaryFunc& op)
+    {
+        _details::scratch_buffer<unsigned int> flags(accl_view, output_view.extent.size());
+        concurrency::array_view<unsigned int, 1> flags_vw = flags.view();
+        _details::segment_flags_from_offsets(accl_view, offsets_view, flags_vw);
+        segmented_scan_exclusive(accl_view, input_view, output_view, flags_vw, op);
+    }
+
+    template <typename IndexableView, typename OffsetIndexableView, typename _BinaryFunc>
+    void segmented_scan_exclusive_by_offsets(const IndexableView& input_view, IndexableView& output_view, const OffsetIndexableView& offsets_view, const _BinaryFunc& op)
+    {
+        segmented_scan_exclusive_by_offsets(_details::auto_select_target(), input_view, output_view, offsets_view, op);
+    }
+
+    template <typename IndexableView, typename OffsetIndexableView, typename _BinaryFunc>
+    void segmented_scan_inclusive_by_offsets(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, const OffsetIndexableView& offsets_view, const _BinaryFunc& op)
+    {
+        _details::scratch_buffer<unsigned int> flags(accl_view, output_view.extent.size());
+        concurrency::array_view<unsigned int, 1> flags_vw = flags.view();
+        _details::segment_flags_from_offsets(accl_view, offsets_view, flags_vw);
+        segmented_scan_inclusive(accl_view, input_view, output_view, flags_vw, op);
+    }
+
+    template <typename IndexableView, typename OffsetIndexableView, typename _BinaryFunc>
+    void segmented_scan_inclusive_by_offsets(const IndexableView& input_view, IndexableView& output_view, const OffsetIndexableView& offsets_view, const _BinaryFunc& op)
+    {
+        segmented_scan_inclusive_by_offsets(_details::auto_select_target(), input_view, output_view, offsets_view, op);
+    }
+
+    //----------------------------------------------------------------------------
+    // multi_scan_exclusive & multi_scan_inclusive
+    //----------------------------------------------------------------------------
+    //
+    // Scans each row of a Rank 2 view independently in a single scan. Rows shorter than a tile are packed together
+    // into tiles, so many short rows cost no more than a single scan of the same number of elements.
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void multi_scan_exclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, const _BinaryFunc& op)
+    {
+        _details::multi_scan<_details::scan_default_tile_size, scan_mode::exclusive>(accl_view, input_view, output_view, op, operator_identity<_BinaryFunc>::value());
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void multi_scan_exclusive(const IndexableView& input_view, IndexableView& output_view, const _BinaryFunc& op)
+    {
+        multi_scan_exclusive(_details::auto_select_target(), input_view, output_view, op);
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void multi_scan_inclusive(const concurrency::accelerator_view& accl_view, const IndexableView& input_view, IndexableView& output_view, const _BinaryFunc& op)
+    {
+        _details::multi_scan<_details::scan_default_tile_size, scan_mode::inclusive>(accl_view, input_view, output_view, op, operator_identity<_BinaryFunc>::value());
+    }
+
+    template <typename IndexableView, typename _BinaryFunc>
+    void multi_scan_inclusive(const IndexableView& input_view, IndexableView& output_view, const _BinaryFunc& op)
+    {
+        multi_scan_inclusive(_details::auto_select_target(), input_view, output_view, op);
     }
 
     //----------------------------------------------------------------------------
@@ -753,3 +1444,5 @@ namespace amp_algorithms
         ::amp_algorithms::transform(_details::auto_select_target(), input_view1, input_view2, output_view, func);
     }
 } // namespace amp_algorithms
+
+#include <xx_amp_algorithms_host_keywords_pop.h>
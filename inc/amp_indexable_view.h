@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <xx_amp_algorithms_host_keywords_push.h>
+
 namespace amp_algorithms
 {
     using namespace concurrency;
@@ -45,15 +47,15 @@ namespace amp_algorithms
     {
         typedef typename view::value_type value_type;
         static const int rank = view::rank;
-        static const bool is_writable = std::is_convertible<typename decltype(std::declval<view>()[std::declval<concurrency::index<rank>>()]), value_type&>::value;
+        static const bool is_writable = std::is_convertible<decltype(std::declval<view>()[std::declval<concurrency::index<rank>>()]), value_type&>::value;
 
         // TODO: Other traits such as whether the storage is dense in LSD or in which dimension is the storage contiguous
 
-        static_assert(std::is_convertible<typename decltype(std::declval<view>().extent), const concurrency::extent<rank>&>::value, "Not a valid indexable_view. Should have a member 'extent'");
+        static_assert(std::is_convertible<decltype(std::declval<view>().extent), const concurrency::extent<rank>&>::value, "Not a valid indexable_view. Should have a member 'extent'");
 
         // TODO: This needs to ensure that the operator() has both the cpu and amp restriction qualifiers. The current check 
         // checks that it has the required parameter and return types and just the "cpu" restriction qualifier.
-        static_assert(std::is_convertible<typename decltype(std::declval<view>()[std::declval<concurrency::index<rank>>()]), const value_type&>::value, "Not a valid indexable_view.");
+        static_assert(std::is_convertible<decltype(std::declval<view>()[std::declval<concurrency::index<rank>>()]), const value_type&>::value, "Not a valid indexable_view.");
 
         // TODO: More checks to statically verify the view template parameter and issue appropriate errors.
     };
@@ -72,6 +74,9 @@ namespace amp_algorithms
         functor_view(const concurrency::extent<rank> &ext, const Functor &functor)
             : _M_extent(ext), _M_functor(functor)
         {
+#if defined(AMP_ALGORITHMS_HOST_BACKEND)
+            extent = ext;
+#endif
         }
 
         functor_return_type operator[](const concurrency::index<rank> &idx) const restrict(cpu, amp)
@@ -79,7 +84,12 @@ namespace amp_algorithms
             return _M_functor(idx);
         }
 
+#if defined(AMP_ALGORITHMS_HOST_BACKEND)
+        // The host backend does not support properties so the extent is a data member.
+        Concurrency::extent<rank> extent;
+#else
         __declspec(property(get=get_extent)) Concurrency::extent<rank> extent;
+#endif
         Concurrency::extent<rank> get_extent() const restrict(cpu,amp)
         {
             return _M_extent;
@@ -99,3 +109,5 @@ namespace amp_algorithms
     }
 
 } // namespace amp_algorithms
+
+#include <xx_amp_algorithms_host_keywords_pop.h>
@@ -21,10 +21,15 @@
 
 #pragma once
 
+#if defined(_MSC_VER) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
 #include <amp.h>
+#else
+#include <xx_amp_algorithms_host_impl.h>
+#endif
 #include <iterator>
 #include <type_traits>
 #include <xx_amp_stl_algorithms_impl.h>
+#include <xx_amp_algorithms_host_keywords_push.h>
 
 namespace amp_stl_algorithms
 {
@@ -53,18 +58,22 @@ namespace amp_stl_algorithms
     }
 
     template <typename value_type>
-    class array_view_iterator : public std::iterator<std::random_access_iterator_tag, typename value_type, int>
+    class array_view_iterator : public std::iterator<std::random_access_iterator_tag, value_type, int>
     {
-        template <typename value_type>
+        template <typename T>
         friend struct _details::array_view_iterator_helper;
 
-        template <typename value_type>
-        friend array_view_iterator<value_type> begin(const concurrency::array_view<value_type>& arr) restrict(cpu,amp);
+        template <typename T>
+        friend array_view_iterator<T> begin(const concurrency::array_view<T>& arr) restrict(cpu,amp);
 
-        template <typename value_type>
-        friend array_view_iterator<value_type> end(const concurrency::array_view<value_type>& arr) restrict(cpu,amp);
+        template <typename T>
+        friend array_view_iterator<T> end(const concurrency::array_view<T>& arr) restrict(cpu,amp);
 
     public:
+        typedef int difference_type;
+        typedef value_type* pointer;
+        typedef value_type& reference;
+
         ~array_view_iterator() restrict(cpu,amp)
         {
         }
@@ -162,9 +171,6 @@ namespace amp_stl_algorithms
             return (m_position - other.m_position);
         }
 
-        friend array_view_iterator operator+(difference_type delta, const array_view_iterator&) restrict(cpu,amp);
-        friend array_view_iterator operator-(difference_type delta, const array_view_iterator&) restrict(cpu,amp);
-
         bool operator < (const array_view_iterator& rhs) const restrict(cpu,amp)
         {
             return (m_position < rhs.m_position);
@@ -263,7 +269,7 @@ namespace amp_stl_algorithms
     {
         iterator_traits()
         {
-            static_assert(false, "This class must be specialized");
+            static_assert(sizeof(array_type) == 0, "This class must be specialized");
         }
     };
 
@@ -298,4 +304,6 @@ namespace amp_stl_algorithms
         return array_view_iterator<value_type>(arr, arr.get_extent().size());
     }
 
-} // amp_stl_algorithms
\ No newline at end of file
+} // amp_stl_algorithms
+
+#include <xx_amp_algorithms_host_keywords_pop.h>
@@ -21,9 +21,10 @@
 #pragma once
 
 #include <utility>
-#include <xx_amp_algorithms_impl.h>
+#include <amp_algorithms.h>
 #include <xx_amp_algorithms_impl_inl.h>
 #include <amp_iterators.h>
+#include <xx_amp_algorithms_host_keywords_push.h>
 
 // TODO: Get the tests, header and internal implementations into the same logical order.
 // TODO: consider supporting the heap functions (is_heap etc)
@@ -235,7 +236,8 @@ namespace amp_stl_algorithms
     template<typename ConstRandomAccessIterator, typename UnaryPredicate>
     bool none_of( ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p ); 
 
-    // non-standard versions which store the result on the accelerator
+    // non-standard versions which store the result on the accelerator, *dest is always overwritten with 1 if the
+    // result is true and 0 if it is false, so any value it held before the call is discarded
     template<typename ConstRandomAccessIterator,  typename UnaryPredicate, typename OutputIterator>
     void all_of(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p, OutputIterator dest );
 
@@ -245,6 +247,16 @@ namespace amp_stl_algorithms
     template<typename ConstRandomAccessIterator,  typename UnaryPredicate, typename OutputIterator>
     void none_of(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p, OutputIterator dest );
 
+    // non-standard versions which return a future and do not block the host
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+    std::future<bool> all_of_async(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p );
+
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+    std::future<bool> any_of_async(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p );
+
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+    std::future<bool> none_of_async(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p );
+
     //----------------------------------------------------------------------------
     // copy, copy_if, copy_n, copy_backward
     //----------------------------------------------------------------------------
@@ -292,14 +304,12 @@ namespace amp_stl_algorithms
         ConstRandomAccessIterator2 first2, 
         BinaryPredicate p );
 
-    // TODO: NOT IMPLEMENTED equal_range
     template<typename ConstRandomAccessIterator, typename T>
     std::pair<ConstRandomAccessIterator,ConstRandomAccessIterator> 
         equal_range( ConstRandomAccessIterator first, 
         ConstRandomAccessIterator last,
         const T& value ); 
 
-    // NOT IMPLEMENTED
     template<typename ConstRandomAccessIterator, typename T, typename Compare>
     std::pair<ConstRandomAccessIterator,ConstRandomAccessIterator> 
         equal_range( ConstRandomAccessIterator first, 
@@ -307,6 +317,26 @@ namespace amp_stl_algorithms
         const T& value, 
         Compare comp ); 
 
+    // Batched equal_range, writes the lower and upper bound of each of the values as an index into [first, last).
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    std::pair<RandomAccessIterator1, RandomAccessIterator2> 
+        equal_range( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator1 lower_result,
+        RandomAccessIterator2 upper_result );
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator1, typename RandomAccessIterator2, typename Compare>
+    std::pair<RandomAccessIterator1, RandomAccessIterator2> 
+        equal_range( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator1 lower_result,
+        RandomAccessIterator2 upper_result,
+        Compare comp );
+
     //----------------------------------------------------------------------------
     // fill, fill_n
     //----------------------------------------------------------------------------
@@ -473,43 +503,69 @@ namespace amp_stl_algorithms
     // lower_bound, upper_bound
     //----------------------------------------------------------------------------
 
-    // TODO: NOT IMPLEMENTED lower_bound
     template<typename ConstRandomAccessIterator, typename T>
     ConstRandomAccessIterator lower_bound( ConstRandomAccessIterator first, 
         ConstRandomAccessIterator last,
         const T& value ); 
 
-    // NOT IMPLEMENTED 
     template<typename ConstRandomAccessIterator, typename T, typename Compare>
     ConstRandomAccessIterator lower_bound( ConstRandomAccessIterator first, 
         ConstRandomAccessIterator last,
         const T& value, Compare comp ); 
 
-    // TODO: NOT IMPLEMENTED upper_bound
+    // Batched lower_bound, writes the lower bound of each of the values as an index into [first, last).
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator>
+    RandomAccessIterator lower_bound( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result );
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator lower_bound( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result,
+        Compare comp );
+
     template<typename ConstRandomAccessIterator, typename T>
     ConstRandomAccessIterator upper_bound( ConstRandomAccessIterator first, 
         ConstRandomAccessIterator last,
         const T& value ); 
 
-    // NOT IMPLEMENTED
     template<typename ConstRandomAccessIterator, typename T, typename Compare>
     ConstRandomAccessIterator upper_bound( ConstRandomAccessIterator first, 
         ConstRandomAccessIterator last,
         const T& value, Compare comp ); 
 
+    // Batched upper_bound, writes the upper bound of each of the values as an index into [first, last).
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator>
+    RandomAccessIterator upper_bound( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result );
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator upper_bound( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result,
+        Compare comp );
+
     //----------------------------------------------------------------------------
     // merge, inplace_merge
     //----------------------------------------------------------------------------
 
-    // TODO: NOT IMPLEMENTED merge
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
     RandomAccessIterator merge( ConstRandomAccessIterator1 first1, 
-        ConstRandomAccessIterator1 fast1,
+        ConstRandomAccessIterator1 last1,
         ConstRandomAccessIterator2 first2, 
         ConstRandomAccessIterator2 last2, 
         RandomAccessIterator result);
 
-    // NOT IMPLEMENTED
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename BinaryPredicate>
     RandomAccessIterator merge( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -518,13 +574,11 @@ namespace amp_stl_algorithms
         RandomAccessIterator result,
         BinaryPredicate comp);
 
-    // TODO: NOT IMPLEMENTED inplace_merge
     template<typename RandomAccessIterator>
     void inplace_merge( RandomAccessIterator first,
         RandomAccessIterator middle,
         RandomAccessIterator last ); 
 
-    // NOT IMPLEMENTED
     template<typename RandomAccessIterator, typename Compare>
     void inplace_merge( RandomAccessIterator first,
         RandomAccessIterator middle,
@@ -535,18 +589,18 @@ namespace amp_stl_algorithms
     // minmax, max_element, min_element, minmax_element
     //----------------------------------------------------------------------------
 
-    template <typename T>
-    inline amp_stl_algorithms::pair<const T, const T> minmax(const T a, const T b) restrict( cpu)
-    {
-        return minmax(a, b, amp_algorithms::less<T>());
-    }
-
     template <typename T, typename Compare>
     inline amp_stl_algorithms::pair<const T, const T> minmax(const T a, const T b, Compare comp) restrict(cpu)
     {
         return comp(a, b) ? amp_stl_algorithms::pair<const T, const T>(a, b) : amp_stl_algorithms::pair<const T, const T>(b, a);
     }
 
+    template <typename T>
+    inline amp_stl_algorithms::pair<const T, const T> minmax(const T a, const T b) restrict( cpu)
+    {
+        return minmax(a, b, amp_algorithms::less<T>());
+    }
+
     // TODO: enable initializer list in amp restricted code
     //
     // template<typename T>
@@ -597,12 +651,10 @@ namespace amp_stl_algorithms
     // mismatch
     //----------------------------------------------------------------------------
 
-    // TODO: NOT IMPLEMENTED mismatch
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2>
     std::pair<ConstRandomAccessIterator1,ConstRandomAccessIterator2>
         mismatch( ConstRandomAccessIterator1 first1, ConstRandomAccessIterator1 last1, ConstRandomAccessIterator2 first2 );
 
-    // NOT IMPLEMENTED 
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename BinaryPredicate>
     std::pair<ConstRandomAccessIterator1,ConstRandomAccessIterator2>
         mismatch( ConstRandomAccessIterator1 first1,
@@ -627,21 +679,34 @@ namespace amp_stl_algorithms
         RandomAccessIterator d_last ); 
 
     //----------------------------------------------------------------------------
-    // nth_element
+    // nth_element, top_k
     //----------------------------------------------------------------------------
 
-    // TODO: NOT IMPLEMENTED nth_element
     template<typename RandomAccessIterator>
     void nth_element( RandomAccessIterator first, 
         RandomAccessIterator nth, 
         RandomAccessIterator last ); 
 
-    // NOT IMPLEMENTED 
     template<typename RandomAccessIterator, typename Compare>
     void nth_element( RandomAccessIterator first, 
         RandomAccessIterator nth,
         RandomAccessIterator last, Compare comp ); 
 
+    // Not part of the STL. Copies the k largest elements of [first, last) to d_first, largest first, without sorting
+    // the whole range. Returns the end of the copied elements.
+    template<typename ConstRandomAccessIterator, typename Size, typename RandomAccessIterator>
+    RandomAccessIterator top_k( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        Size k,
+        RandomAccessIterator d_first );
+
+    template<typename ConstRandomAccessIterator, typename Size, typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator top_k( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        Size k,
+        RandomAccessIterator d_first,
+        Compare comp );
+
     //----------------------------------------------------------------------------
     // partial sum
     //----------------------------------------------------------------------------
@@ -663,19 +728,15 @@ namespace amp_stl_algorithms
     // partition, stable_partition, partition_point, is_partitioned
     //----------------------------------------------------------------------------
 
-    // TODO: NOT IMPLEMENTED is_partitioned
     template<typename ConstRandomAccessIterator, typename UnaryPredicate>
     bool is_partitioned( ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p );
 
-    // TODO: NOT IMPLEMENTED partition
     template<typename RandomAccessIterator, typename UnaryPredicate>
-    RandomAccessIterator partition( RandomAccessIterator first, RandomAccessIterator last, UnaryPredicate comp);
+    RandomAccessIterator partition( RandomAccessIterator first, RandomAccessIterator last, UnaryPredicate p );
 
-    // TODO: NOT IMPLEMENTED stable_partition
     template<typename RandomAccessIterator, typename UnaryPredicate>
     RandomAccessIterator stable_partition( RandomAccessIterator first, RandomAccessIterator last, UnaryPredicate p );
 
-    // TODO: NOT IMPLEMENTED partition_point
     template<typename ConstRandomAccessIterator, typename UnaryPredicate>
     ConstRandomAccessIterator partition_point( ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p);
 
@@ -804,22 +865,35 @@ namespace amp_stl_algorithms
         const Type& val, 
         Predicate p);
 
-    // TODO: NOT IMPLEMENTED binary_search
     template<typename ConstRandomAccessIterator, typename T>
     bool binary_search( ConstRandomAccessIterator first, ConstRandomAccessIterator last, const T& value ); 
 
-    // NOT IMPLEMENTED
     template<typename ConstRandomAccessIterator, typename T, typename Compare>
     bool binary_search( ConstRandomAccessIterator first, 
         ConstRandomAccessIterator last,
         const T& value, 
         Compare comp );
 
+    // Batched binary_search, writes 1 for each of the values found in [first, last) and 0 otherwise.
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator>
+    RandomAccessIterator binary_search( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result );
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator binary_search( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result,
+        Compare comp );
+
     //----------------------------------------------------------------------------
     // set_difference, set_intersection, set_symetric_distance, set_union
     //----------------------------------------------------------------------------
 
-    // TODO: NOT IMPLEMENTED set_difference
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
     RandomAccessIterator set_difference( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -827,7 +901,6 @@ namespace amp_stl_algorithms
         ConstRandomAccessIterator2 last2,
         RandomAccessIterator d_first ); 
 
-    // NOT IMPLEMENTED
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename Compare>
     RandomAccessIterator set_difference( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -836,7 +909,6 @@ namespace amp_stl_algorithms
         RandomAccessIterator d_first, 
         Compare comp ); 
 
-    // TODO: NOT IMPLEMENTED set_intersection
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
     RandomAccessIterator set_intersection( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -844,7 +916,6 @@ namespace amp_stl_algorithms
         ConstRandomAccessIterator2 last2,
         RandomAccessIterator d_first ); 
 
-    // NOT IMPLEMENTED
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename Compare>
     RandomAccessIterator set_intersection( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -853,7 +924,6 @@ namespace amp_stl_algorithms
         RandomAccessIterator d_first, 
         Compare comp ); 
 
-    // TODO: NOT IMPLEMENTED set_symmetric_difference
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
     RandomAccessIterator set_symmetric_difference( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -861,7 +931,6 @@ namespace amp_stl_algorithms
         ConstRandomAccessIterator2 last2,
         RandomAccessIterator d_first ); 
 
-    // NOT IMPLEMENTED
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename Compare>
     RandomAccessIterator set_symmetric_difference( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -870,7 +939,6 @@ namespace amp_stl_algorithms
         RandomAccessIterator d_first, 
         Compare comp); 
 
-    // TODO: NOT IMPLEMENTED set_union
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
     RandomAccessIterator set_union( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -878,7 +946,6 @@ namespace amp_stl_algorithms
         ConstRandomAccessIterator2 last2,
         RandomAccessIterator d_first ); 
 
-    // NOT IMPLEMENTED
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename Compare>
     RandomAccessIterator set_union( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1,
@@ -929,34 +996,28 @@ namespace amp_stl_algorithms
     template<typename ConstRandomAccessIterator, typename Compare>
     ConstRandomAccessIterator is_sorted_until( ConstRandomAccessIterator first, ConstRandomAccessIterator last, Compare comp ); 
 
-    // TODO: NOT IMPLEMENTED sort
     template<typename RandomAccessIterator>
     void sort( RandomAccessIterator first, RandomAccessIterator last );
 
-    // NOT IMPLEMENTED 
     template<typename RandomAccessIterator, typename Compare>
     void sort( RandomAccessIterator first, RandomAccessIterator last, Compare comp ); 
 
-    // TODO: NOT IMPLEMENTED partial_sort
     template<typename RandomAccessIterator>
     void partial_sort( RandomAccessIterator first, 
         RandomAccessIterator middle, 
         RandomAccessIterator last );
 
-    // NOT IMPLEMENTED 
     template<typename RandomAccessIterator, typename Compare>
     void partial_sort( RandomAccessIterator first, 
         RandomAccessIterator middle,
         RandomAccessIterator last, Compare comp );
 
-    // TODO: NOT IMPLEMENTED partial_sort_copy
     template<typename ConstRandomAccessIterator,typename RandomAccessIterator>
     RandomAccessIterator partial_sort_copy( ConstRandomAccessIterator first,
         ConstRandomAccessIterator last,
         RandomAccessIterator d_first, 
         RandomAccessIterator d_last ); 
 
-    // NOT IMPLEMENTED 
     template<typename ConstRandomAccessIterator,typename RandomAccessIterator, typename Compare>
     RandomAccessIterator partial_sort_copy( ConstRandomAccessIterator first, 
         ConstRandomAccessIterator last,
@@ -964,11 +1025,9 @@ namespace amp_stl_algorithms
         RandomAccessIterator d_last,
         Compare comp ); 
 
-    // TODO: NOT IMPLEMENTED stable_sort
     template<typename RandomAccessIterator>
     void stable_sort( RandomAccessIterator first, RandomAccessIterator last );
 
-    // NOT IMPLEMENTED 
     template<typename RandomAccessIterator, typename Compare>
     void stable_sort( RandomAccessIterator first, RandomAccessIterator last, Compare comp ); 
 
@@ -1011,22 +1070,21 @@ namespace amp_stl_algorithms
     // unique, unique_copy
     //----------------------------------------------------------------------------
 
-    // TODO: NOT IMPLEMENTED unique
-    template<typename ConstRandomAccessIterator>
-    ConstRandomAccessIterator unique( ConstRandomAccessIterator first, ConstRandomAccessIterator last);
+    template<typename RandomAccessIterator>
+    RandomAccessIterator unique( RandomAccessIterator first, RandomAccessIterator last);
 
-    // NOT IMPLEMENTED 
-    template<typename ConstRandomAccessIterator, typename BinaryPredicate>
-    ConstRandomAccessIterator unique( ConstRandomAccessIterator first, ConstRandomAccessIterator last, BinaryPredicate comp);
+    template<typename RandomAccessIterator, typename BinaryPredicate>
+    RandomAccessIterator unique( RandomAccessIterator first, RandomAccessIterator last, BinaryPredicate p);
 
-    // TODO: NOT IMPLEMENTED unique_copy
     template<typename ConstRandomAccessIterator,typename RandomAccessIterator>
-    ConstRandomAccessIterator unique_copy( ConstRandomAccessIterator first, ConstRandomAccessIterator last, RandomAccessIterator d_first ); 
+    RandomAccessIterator unique_copy( ConstRandomAccessIterator first, ConstRandomAccessIterator last, RandomAccessIterator dest_first ); 
 
-    // NOT IMPLEMENTED 
     template<typename ConstRandomAccessIterator,typename RandomAccessIterator, typename BinaryPredicate>
-    ConstRandomAccessIterator unique_copy( ConstRandomAccessIterator first, 
+    RandomAccessIterator unique_copy( ConstRandomAccessIterator first, 
         ConstRandomAccessIterator last, 
-        RandomAccessIterator d_first, 
+        RandomAccessIterator dest_first, 
         BinaryPredicate p); 
 }// namespace amp_stl_algorithms
+
+#include <xx_amp_stl_algorithms_impl_inl.h>
+#include <xx_amp_algorithms_host_keywords_pop.h>
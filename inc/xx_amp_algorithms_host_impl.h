@@ -0,0 +1,1748 @@
+/*----------------------------------------------------------------------------
+* Copyright (c) Microsoft Corp.
+*
+* Licensed under the Apache License, Version 2.0 (the "License"); you may not
+* use this file except in compliance with the License.  You may obtain a copy
+* of the License at http://www.apache.org/licenses/LICENSE-2.0
+*
+* THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED
+* WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE,
+* MERCHANTABLITY OR NON-INFRINGEMENT.
+*
+* See the Apache Version 2.0 License for specific language governing
+* permissions and limitations under the License.
+*---------------------------------------------------------------------------
+*
+* C++ AMP algorithms library.
+*
+* This file contains the host execution backend. It provides the subset of the
+* C++ AMP runtime used by the library, implemented on a pool of worker threads,
+* so that the library can be used on platforms without a C++ AMP compiler,
+* for example Linux with GCC or Clang.
+*
+* The backend is selected automatically when the compiler is not Visual C++. It
+* can also be selected by defining AMP_ALGORITHMS_HOST_BACKEND before including
+* any of the library headers, in which case <amp.h> must not be included.
+*---------------------------------------------------------------------------*/
+
+#pragma once
+
+#ifndef AMP_ALGORITHMS_HOST_BACKEND
+#define AMP_ALGORITHMS_HOST_BACKEND
+#endif
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if !(defined(__x86_64__) && defined(__GNUC__))
+#include <ucontext.h>
+#endif
+
+// The library headers define restrict and tile_static only while they are being read, see
+// xx_amp_algorithms_host_keywords_push.h, as restrict is a common identifier. Code that writes
+// its own restrict(amp) kernels for the host backend can define AMP_ALGORITHMS_HOST_KEYWORDS
+// before including the library to keep them defined.
+
+#if defined(AMP_ALGORITHMS_HOST_KEYWORDS)
+#define restrict(...)
+#define tile_static static thread_local
+#endif
+
+// Error code of the exceptions thrown for invalid arguments, normally defined by the Windows headers.
+#ifndef E_INVALIDARG
+#define E_INVALIDARG (static_cast<int>(0x80070057L))
+#endif
+
+// Number of worker threads, in addition to the calling thread, used to run kernels. Defaults to one
+// less than the number of hardware threads.
+#ifndef AMP_ALGORITHMS_HOST_WORKER_COUNT
+#define AMP_ALGORITHMS_HOST_WORKER_COUNT (std::max(1u, std::thread::hardware_concurrency()) - 1)
+#endif
+
+// Stack size of each fiber used to run the threads of a tile.
+#ifndef AMP_ALGORITHMS_HOST_FIBER_STACK_SIZE
+#define AMP_ALGORITHMS_HOST_FIBER_STACK_SIZE (64 * 1024)
+#endif
+
+namespace amp_algorithms
+{
+    namespace _details
+    {
+        namespace host
+        {
+            //----------------------------------------------------------------------------
+            // host_executor
+            //
+            // A pool of worker threads. Tasks are claimed in increasing order and each
+            // task runs to completion on the thread that claimed it, so a task may wait
+            // for a lower numbered task without deadlocking.
+            //----------------------------------------------------------------------------
+
+            class host_executor
+            {
+            public:
+                static host_executor& instance()
+                {
+                    static host_executor executor;
+                    return executor;
+                }
+
+                ~host_executor()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_stop = true;
+                    }
+                    m_wake.notify_all();
+                    for (auto& w : m_workers)
+                    {
+                        w.join();
+                    }
+                }
+
+                // Number of threads, including the calling thread, that run tasks.
+                unsigned int thread_count() const
+                {
+                    return unsigned(m_workers.size()) + 1;
+                }
+
+                // Runs task(i) for every i in [0, count) and returns once they have all completed.
+                template <typename Task>
+                void run(const int count, const Task& task)
+                {
+                    if (count <= 0)
+                    {
+                        return;
+                    }
+                    if ((count == 1) || m_workers.empty())
+                    {
+                        for (int i = 0; i < count; ++i)
+                        {
+                            task(i);
+                        }
+                        return;
+                    }
+
+                    std::lock_guard<std::mutex> run_lock(m_run_mutex);
+                    job j(count, &invoke<Task>, &task);
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_job = &j;
+                        ++m_generation;
+                    }
+                    m_wake.notify_all();
+
+                    work(j);
+
+                    // Wait for the workers which joined this job to leave it.
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_job = nullptr;
+                    m_done.wait(lock, [&j] { return j.active == 0; });
+                }
+
+            private:
+                struct job
+                {
+                    job(int count, void(*invoke)(const void*, int), const void* task)
+                        : count(count), next(0), active(0), invoke(invoke), task(task)
+                    { }
+
+                    const int count;
+                    std::atomic<int> next;
+                    int active;
+                    void(*const invoke)(const void*, int);
+                    const void* const task;
+                };
+
+                host_executor() : m_job(nullptr), m_generation(0), m_stop(false)
+                {
+                    const unsigned int worker_count = AMP_ALGORITHMS_HOST_WORKER_COUNT;
+                    for (unsigned int i = 0; i < worker_count; ++i)
+                    {
+                        m_workers.emplace_back([this] { worker_loop(); });
+                    }
+                }
+
+                host_executor(const host_executor&) = delete;
+                host_executor& operator=(const host_executor&) = delete;
+
+                template <typename Task>
+                static void invoke(const void* task, int i)
+                {
+                    (*static_cast<const Task*>(task))(i);
+                }
+
+                static void work(job& j)
+                {
+                    for (int i = j.next.fetch_add(1); i < j.count; i = j.next.fetch_add(1))
+                    {
+                        j.invoke(j.task, i);
+                    }
+                }
+
+                void worker_loop()
+                {
+                    unsigned long long seen = 0;
+                    for (;;)
+                    {
+                        job* j;
+                        {
+                            std::unique_lock<std::mutex> lock(m_mutex);
+                            m_wake.wait(lock, [&] { return m_stop || ((m_job != nullptr) && (m_generation != seen)); });
+                            if (m_stop)
+                            {
+                                return;
+                            }
+                            seen = m_generation;
+                            j = m_job;
+                            ++j->active;
+                        }
+                        work(*j);
+                        {
+                            std::lock_guard<std::mutex> lock(m_mutex);
+                            --j->active;
+                        }
+                        m_done.notify_all();
+                    }
+                }
+
+                std::vector<std::thread> m_workers;
+                std::mutex m_run_mutex;
+                std::mutex m_mutex;
+                std::condition_variable m_wake;
+                std::condition_variable m_done;
+                job* m_job;
+                unsigned long long m_generation;
+                bool m_stop;
+            };
+
+            //----------------------------------------------------------------------------
+            // tile_fibers
+            //
+            // Runs the threads of a tile as fibers on the calling thread. A fiber which
+            // waits on the tile barrier is suspended until all the other fibers in the
+            // tile have reached the barrier or completed. A fiber which yields is resumed
+            // after every other runnable fiber has run, this is used to emulate the lock
+            // step execution of the threads in a warp.
+            //----------------------------------------------------------------------------
+
+#if defined(__x86_64__) && defined(__GNUC__)
+            // Saves the callee saved registers on the current stack, stores the stack pointer
+            // in *from and resumes the fiber whose saved stack pointer is to.
+#if defined(__clang__)
+            __attribute__((naked, noinline))
+#else
+            __attribute__((naked, noinline, noipa))
+#endif
+            inline void switch_fiber(void** /*from*/, void* /*to*/)
+            {
+                __asm__(
+                    "pushq %rbp\n\t"
+                    "pushq %rbx\n\t"
+                    "pushq %r12\n\t"
+                    "pushq %r13\n\t"
+                    "pushq %r14\n\t"
+                    "pushq %r15\n\t"
+                    "movq %rsp, (%rdi)\n\t"
+                    "movq %rsi, %rsp\n\t"
+                    "popq %r15\n\t"
+                    "popq %r14\n\t"
+                    "popq %r13\n\t"
+                    "popq %r12\n\t"
+                    "popq %rbx\n\t"
+                    "popq %rbp\n\t"
+                    "ret\n\t");
+            }
+#endif
+
+            class tile_fibers
+            {
+            public:
+                static tile_fibers& current()
+                {
+                    static thread_local tile_fibers fibers;
+                    return fibers;
+                }
+
+                // Runs lane(0) ... lane(count - 1), each on its own fiber.
+                template <typename Lane>
+                void run(const int count, const Lane& lane)
+                {
+                    while (int(m_fibers.size()) < count)
+                    {
+                        m_fibers.emplace_back();
+                    }
+                    m_invoke = &invoke<Lane>;
+                    m_lane = &lane;
+                    for (int i = 0; i < count; ++i)
+                    {
+                        start(m_fibers[i]);
+                    }
+
+                    int remaining = count;
+                    m_runnable = count;
+                    while (remaining > 0)
+                    {
+                        for (int i = 0; i < count; ++i)
+                        {
+                            if (m_fibers[i].state != fiber_state::runnable)
+                            {
+                                continue;
+                            }
+                            m_active = i;
+                            resume(m_fibers[i]);
+                            if (m_fibers[i].state == fiber_state::finished)
+                            {
+                                --remaining;
+                            }
+                        }
+
+                        // Release the barrier once every fiber has either reached it or completed.
+                        if (m_runnable == 0)
+                        {
+                            for (int i = 0; i < count; ++i)
+                            {
+                                if (m_fibers[i].state == fiber_state::waiting)
+                                {
+                                    m_fibers[i].state = fiber_state::runnable;
+                                }
+                            }
+                            m_runnable = remaining;
+                        }
+                    }
+                    m_active = -1;
+                }
+
+                // Called by a fiber to wait for the other fibers in its tile.
+                void wait()
+                {
+                    if (m_active >= 0)
+                    {
+                        m_fibers[m_active].state = fiber_state::waiting;
+                        --m_runnable;
+                        suspend(m_fibers[m_active]);
+                    }
+                }
+
+                // Called by a fiber to let the other runnable fibers in its tile run.
+                void yield()
+                {
+                    if (m_active >= 0)
+                    {
+                        suspend(m_fibers[m_active]);
+                    }
+                }
+
+            private:
+                enum class fiber_state
+                {
+                    runnable,
+                    waiting,
+                    finished
+                };
+
+                struct fiber
+                {
+                    fiber() : stack(new char[AMP_ALGORITHMS_HOST_FIBER_STACK_SIZE]), state(fiber_state::finished)
+                    { }
+
+                    std::unique_ptr<char[]> stack;
+                    fiber_state state;
+#if defined(__x86_64__) && defined(__GNUC__)
+                    void* stack_pointer;
+#else
+                    ucontext_t context;
+#endif
+                };
+
+                tile_fibers() : m_active(-1), m_runnable(0), m_invoke(nullptr), m_lane(nullptr)
+                { }
+
+                template <typename Lane>
+                static void invoke(const void* lane, int i)
+                {
+                    (*static_cast<const Lane*>(lane))(i);
+                }
+
+                static void entry()
+                {
+                    tile_fibers& self = current();
+                    const int i = self.m_active;
+                    self.m_invoke(self.m_lane, i);
+                    self.m_fibers[i].state = fiber_state::finished;
+                    --self.m_runnable;
+                    self.suspend(self.m_fibers[i]);
+                }
+
+#if defined(__x86_64__) && defined(__GNUC__)
+                void start(fiber& f)
+                {
+                    // Lay out the stack as switch_fiber expects to find it; six zeroed registers
+                    // followed by the "return address" of the fiber entry point.
+                    char* top = f.stack.get() + AMP_ALGORITHMS_HOST_FIBER_STACK_SIZE;
+                    void** frame = reinterpret_cast<void**>((reinterpret_cast<std::uintptr_t>(top) & ~std::uintptr_t(15)) - 64);
+                    std::fill(frame, frame + 8, nullptr);
+                    frame[6] = reinterpret_cast<void*>(&entry);
+                    f.stack_pointer = frame;
+                    f.state = fiber_state::runnable;
+                }
+
+                void resume(fiber& f)
+                {
+                    switch_fiber(&m_scheduler, f.stack_pointer);
+                }
+
+                void suspend(fiber& f)
+                {
+                    switch_fiber(&f.stack_pointer, m_scheduler);
+                }
+
+                void* m_scheduler;
+#else
+                void start(fiber& f)
+                {
+                    getcontext(&f.context);
+                    f.context.uc_stack.ss_sp = f.stack.get();
+                    f.context.uc_stack.ss_size = AMP_ALGORITHMS_HOST_FIBER_STACK_SIZE;
+                    f.context.uc_link = nullptr;
+                    makecontext(&f.context, &entry, 0);
+                    f.state = fiber_state::runnable;
+                }
+
+                void resume(fiber& f)
+                {
+                    swapcontext(&m_scheduler, &f.context);
+                }
+
+                void suspend(fiber& f)
+                {
+                    swapcontext(&f.context, &m_scheduler);
+                }
+
+                ucontext_t m_scheduler;
+#endif
+                std::vector<fiber> m_fibers;
+                int m_active;
+                int m_runnable;
+                void(*m_invoke)(const void*, int);
+                const void* m_lane;
+            };
+
+            // Emulates a lock step boundary between the threads of a warp. Every thread in the
+            // warp must call this the same number of times to keep them in step.
+            inline void warp_sync()
+            {
+                tile_fibers::current().yield();
+            }
+        } // namespace amp_algorithms::_details::host
+    } // namespace amp_algorithms::_details
+} // namespace amp_algorithms
+
+namespace concurrency
+{
+    //----------------------------------------------------------------------------
+    // index, extent, tiled_extent, tile_barrier, tiled_index
+    //----------------------------------------------------------------------------
+
+    template <int N>
+    class index
+    {
+    public:
+        static const int rank = N;
+        typedef int value_type;
+
+        index()
+        {
+            std::fill(_M_base, _M_base + N, 0);
+        }
+
+        explicit index(int i0)
+        {
+            static_assert(N == 1, "This constructor requires a rank 1 index.");
+            _M_base[0] = i0;
+        }
+
+        index(int i0, int i1)
+        {
+            static_assert(N == 2, "This constructor requires a rank 2 index.");
+            _M_base[0] = i0;
+            _M_base[1] = i1;
+        }
+
+        index(int i0, int i1, int i2)
+        {
+            static_assert(N == 3, "This constructor requires a rank 3 index.");
+            _M_base[0] = i0;
+            _M_base[1] = i1;
+            _M_base[2] = i2;
+        }
+
+        int operator[](int i) const
+        {
+            return _M_base[i];
+        }
+
+        int& operator[](int i)
+        {
+            return _M_base[i];
+        }
+
+        index& operator+=(const index& rhs)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                _M_base[i] += rhs[i];
+            }
+            return *this;
+        }
+
+        index& operator-=(const index& rhs)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                _M_base[i] -= rhs[i];
+            }
+            return *this;
+        }
+
+        // The scalar operators apply the value to every component, as in C++ AMP.
+        index& operator+=(int value)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                _M_base[i] += value;
+            }
+            return *this;
+        }
+
+        index& operator-=(int value)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                _M_base[i] -= value;
+            }
+            return *this;
+        }
+
+        index& operator*=(int value)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                _M_base[i] *= value;
+            }
+            return *this;
+        }
+
+        index& operator/=(int value)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                _M_base[i] /= value;
+            }
+            return *this;
+        }
+
+        index& operator%=(int value)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                _M_base[i] %= value;
+            }
+            return *this;
+        }
+
+        index& operator++()
+        {
+            return *this += 1;
+        }
+
+        index operator++(int)
+        {
+            index old(*this);
+            *this += 1;
+            return old;
+        }
+
+        index& operator--()
+        {
+            return *this -= 1;
+        }
+
+        index operator--(int)
+        {
+            index old(*this);
+            *this -= 1;
+            return old;
+        }
+
+        friend index operator+(index lhs, const index& rhs)
+        {
+            return lhs += rhs;
+        }
+
+        friend index operator-(index lhs, const index& rhs)
+        {
+            return lhs -= rhs;
+        }
+
+        friend index operator+(index lhs, int rhs)
+        {
+            return lhs += rhs;
+        }
+
+        friend index operator+(int lhs, index rhs)
+        {
+            return rhs += lhs;
+        }
+
+        friend index operator-(index lhs, int rhs)
+        {
+            return lhs -= rhs;
+        }
+
+        friend index operator-(int lhs, const index& rhs)
+        {
+            index result;
+            for (int i = 0; i < N; ++i)
+            {
+                result[i] = lhs - rhs[i];
+            }
+            return result;
+        }
+
+        friend index operator*(index lhs, int rhs)
+        {
+            return lhs *= rhs;
+        }
+
+        friend index operator*(int lhs, index rhs)
+        {
+            return rhs *= lhs;
+        }
+
+        friend index operator/(index lhs, int rhs)
+        {
+            return lhs /= rhs;
+        }
+
+        friend index operator%(index lhs, int rhs)
+        {
+            return lhs %= rhs;
+        }
+
+        friend bool operator==(const index& lhs, const index& rhs)
+        {
+            return std::equal(lhs._M_base, lhs._M_base + N, rhs._M_base);
+        }
+
+        friend bool operator!=(const index& lhs, const index& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        int _M_base[N];
+    };
+
+    template <int D0, int D1 = 0, int D2 = 0>
+    class tiled_extent;
+
+    template <int N>
+    class extent
+    {
+    public:
+        static const int rank = N;
+        typedef int value_type;
+
+        extent()
+        {
+            std::fill(_M_base, _M_base + N, 0);
+        }
+
+        explicit extent(int e0)
+        {
+            static_assert(N == 1, "This constructor requires a rank 1 extent.");
+            _M_base[0] = e0;
+        }
+
+        extent(int e0, int e1)
+        {
+            static_assert(N == 2, "This constructor requires a rank 2 extent.");
+            _M_base[0] = e0;
+            _M_base[1] = e1;
+        }
+
+        extent(int e0, int e1, int e2)
+        {
+            static_assert(N == 3, "This constructor requires a rank 3 extent.");
+            _M_base[0] = e0;
+            _M_base[1] = e1;
+            _M_base[2] = e2;
+        }
+
+        int operator[](int i) const
+        {
+            return _M_base[i];
+        }
+
+        int& operator[](int i)
+        {
+            return _M_base[i];
+        }
+
+        unsigned int size() const
+        {
+            unsigned int s = 1;
+            for (int i = 0; i < N; ++i)
+            {
+                s *= unsigned(_M_base[i]);
+            }
+            return s;
+        }
+
+        bool contains(const index<N>& idx) const
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                if ((idx[i] < 0) || (idx[i] >= _M_base[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <int D0>
+        tiled_extent<D0> tile() const
+        {
+            static_assert(N == 1, "One tile dimension requires a rank 1 extent.");
+            return tiled_extent<D0>(*this);
+        }
+
+        template <int D0, int D1>
+        tiled_extent<D0, D1> tile() const
+        {
+            static_assert(N == 2, "Two tile dimensions require a rank 2 extent.");
+            return tiled_extent<D0, D1>(*this);
+        }
+
+        template <int D0, int D1, int D2>
+        tiled_extent<D0, D1, D2> tile() const
+        {
+            static_assert(N == 3, "Three tile dimensions require a rank 3 extent.");
+            return tiled_extent<D0, D1, D2>(*this);
+        }
+
+        friend extent operator/(extent lhs, int value)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                lhs[i] /= value;
+            }
+            return lhs;
+        }
+
+        friend bool operator==(const extent& lhs, const extent& rhs)
+        {
+            return std::equal(lhs._M_base, lhs._M_base + N, rhs._M_base);
+        }
+
+        friend bool operator!=(const extent& lhs, const extent& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        int _M_base[N];
+    };
+
+    namespace details
+    {
+        template <int D0, int D1, int D2>
+        struct _Tile_rank
+        {
+            static const int value = (D2 > 0) ? 3 : ((D1 > 0) ? 2 : 1);
+        };
+
+        template <int N>
+        inline index<N> _Linear_to_index(const extent<N>& ext, int linear)
+        {
+            index<N> idx;
+            for (int i = N - 1; i >= 0; --i)
+            {
+                idx[i] = linear % ext[i];
+                linear /= ext[i];
+            }
+            return idx;
+        }
+    }
+
+    template <int D0, int D1, int D2>
+    class tiled_extent : public extent<details::_Tile_rank<D0, D1, D2>::value>
+    {
+    public:
+        static const int rank = details::_Tile_rank<D0, D1, D2>::value;
+        static const int tile_dim0 = D0;
+        static const int tile_dim1 = D1;
+        static const int tile_dim2 = D2;
+
+        tiled_extent()
+        { }
+
+        tiled_extent(const extent<rank>& ext) : extent<rank>(ext)
+        { }
+
+        extent<rank> get_tile_extent() const
+        {
+            extent<rank> ext;
+            for (int i = 0; i < rank; ++i)
+            {
+                ext[i] = tile_dim(i);
+            }
+            return ext;
+        }
+
+        tiled_extent pad() const
+        {
+            tiled_extent padded(*this);
+            for (int i = 0; i < rank; ++i)
+            {
+                padded[i] = ((padded[i] + tile_dim(i) - 1) / tile_dim(i)) * tile_dim(i);
+            }
+            return padded;
+        }
+
+        tiled_extent truncate() const
+        {
+            tiled_extent truncated(*this);
+            for (int i = 0; i < rank; ++i)
+            {
+                truncated[i] = (truncated[i] / tile_dim(i)) * tile_dim(i);
+            }
+            return truncated;
+        }
+
+        static int tile_dim(int i)
+        {
+            return (i == 0) ? D0 : ((i == 1) ? D1 : D2);
+        }
+    };
+
+    class tile_barrier
+    {
+    public:
+        void wait() const
+        {
+            amp_algorithms::_details::host::tile_fibers::current().wait();
+        }
+
+        void wait_with_all_memory_fence() const
+        {
+            wait();
+        }
+
+        void wait_with_global_memory_fence() const
+        {
+            wait();
+        }
+
+        void wait_with_tile_static_memory_fence() const
+        {
+            wait();
+        }
+    };
+
+    template <int D0, int D1 = 0, int D2 = 0>
+    class tiled_index
+    {
+    public:
+        static const int rank = details::_Tile_rank<D0, D1, D2>::value;
+        static const int tile_dim0 = D0;
+        static const int tile_dim1 = D1;
+        static const int tile_dim2 = D2;
+
+        tiled_index(const index<rank>& global, const index<rank>& local, const index<rank>& tile, const index<rank>& tile_origin, const tile_barrier& barrier)
+            : global(global), local(local), tile(tile), tile_origin(tile_origin), barrier(barrier)
+        { }
+
+        operator const index<rank>() const
+        {
+            return global;
+        }
+
+        extent<rank> get_tile_extent() const
+        {
+            return tiled_extent<D0, D1, D2>().get_tile_extent();
+        }
+
+        const index<rank> global;
+        const index<rank> local;
+        const index<rank> tile;
+        const index<rank> tile_origin;
+        const tile_barrier barrier;
+    };
+
+    inline void all_memory_fence(const tile_barrier&)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    inline void global_memory_fence(const tile_barrier&)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    inline void tile_static_memory_fence(const tile_barrier&)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    //----------------------------------------------------------------------------
+    // accelerator, accelerator_view
+    //----------------------------------------------------------------------------
+
+    class accelerator_view
+    {
+        friend class accelerator;
+
+    public:
+        accelerator_view() : _M_is_cpu(false)
+        { }
+
+        void wait() const
+        { }
+
+        void flush() const
+        { }
+
+        bool operator==(const accelerator_view& other) const
+        {
+            return (_M_is_cpu == other._M_is_cpu);
+        }
+
+        bool operator!=(const accelerator_view& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        explicit accelerator_view(bool is_cpu) : _M_is_cpu(is_cpu)
+        { }
+
+        bool _M_is_cpu;
+    };
+
+    class accelerator
+    {
+    public:
+        static constexpr const wchar_t* default_accelerator = L"default";
+        static constexpr const wchar_t* cpu_accelerator = L"cpu";
+        static constexpr const wchar_t* direct3d_ref = L"direct3d\\ref";
+        static constexpr const wchar_t* direct3d_warp = L"direct3d\\warp";
+
+        accelerator() : accelerator(default_accelerator)
+        { }
+
+        explicit accelerator(const std::wstring& path)
+            : device_path((path == default_accelerator) ? std::wstring(L"host") : path),
+            description(L"Host execution backend"),
+            default_view(path == cpu_accelerator)
+        { }
+
+        accelerator_view create_view() const
+        {
+            return default_view;
+        }
+
+        accelerator_view get_default_view() const
+        {
+            return default_view;
+        }
+
+        bool get_supports_double_precision() const
+        {
+            return true;
+        }
+
+        static accelerator_view get_auto_selection_view()
+        {
+            return accelerator().default_view;
+        }
+
+        static std::vector<accelerator> get_all()
+        {
+            return std::vector<accelerator>(1, accelerator());
+        }
+
+        static bool set_default(const std::wstring& path)
+        {
+            return (path == default_accelerator);
+        }
+
+        bool operator==(const accelerator& other) const
+        {
+            return (device_path == other.device_path);
+        }
+
+        bool operator!=(const accelerator& other) const
+        {
+            return !(*this == other);
+        }
+
+        std::wstring device_path;
+        std::wstring description;
+        accelerator_view default_view;
+    };
+
+    class runtime_exception : public std::runtime_error
+    {
+    public:
+        runtime_exception(const char* message, int error_code) : std::runtime_error(message), _M_error_code(error_code)
+        { }
+
+        int get_error_code() const
+        {
+            return _M_error_code;
+        }
+
+    private:
+        int _M_error_code;
+    };
+
+    class invalid_compute_domain : public runtime_exception
+    {
+    public:
+        explicit invalid_compute_domain(const char* message) : runtime_exception(message, 0)
+        { }
+    };
+
+    //----------------------------------------------------------------------------
+    // array, array_view
+    //
+    // Data is always resident in host memory so synchronization is a no-op. Like
+    // C++ AMP, an array_view keeps the storage of the array it was created from alive.
+    //----------------------------------------------------------------------------
+
+    template <typename T, int N = 1>
+    class array_view;
+
+    template <typename T, int N = 1>
+    class array
+    {
+        template <typename U, int K>
+        friend class array_view;
+
+    public:
+        static const int rank = N;
+        typedef T value_type;
+
+        explicit array(const concurrency::extent<N>& ext) : extent(ext), _M_data(new T[ext.size()](), std::default_delete<T[]>())
+        { }
+
+        array(const concurrency::extent<N>& ext, const accelerator_view&) : array(ext)
+        { }
+
+        array(const concurrency::extent<N>& ext, const accelerator_view&, const accelerator_view&) : array(ext)
+        { }
+
+        template <typename InputIterator>
+        array(const concurrency::extent<N>& ext, InputIterator first, InputIterator last) : array(ext)
+        {
+            std::copy(first, last, _M_data.get());
+        }
+
+        template <typename InputIterator>
+        array(const concurrency::extent<N>& ext, InputIterator first, const accelerator_view&) : array(ext)
+        {
+            std::copy_n(first, ext.size(), _M_data.get());
+        }
+
+        explicit array(int e0) : array(concurrency::extent<N>(e0))
+        { }
+
+        template <typename InputIterator>
+        array(int e0, InputIterator first, const accelerator_view& av) : array(concurrency::extent<N>(e0), first, av)
+        { }
+
+        array(int e0, const accelerator_view&) : array(concurrency::extent<N>(e0))
+        { }
+
+        array(int e0, const accelerator_view&, const accelerator_view&) : array(concurrency::extent<N>(e0))
+        { }
+
+        array(int e0, int e1) : array(concurrency::extent<N>(e0, e1))
+        { }
+
+        array(int e0, int e1, const accelerator_view&) : array(concurrency::extent<N>(e0, e1))
+        { }
+
+        array(const array& other) : array(other.extent)
+        {
+            std::copy(other._M_data.get(), other._M_data.get() + extent.size(), _M_data.get());
+        }
+
+        array& operator=(const array& other)
+        {
+            if (this != &other)
+            {
+                array tmp(other);
+                extent = tmp.extent;
+                _M_data = tmp._M_data;
+            }
+            return *this;
+        }
+
+        T& operator[](const index<N>& idx)
+        {
+            return _M_data.get()[_Offset(idx)];
+        }
+
+        const T& operator[](const index<N>& idx) const
+        {
+            return _M_data.get()[_Offset(idx)];
+        }
+
+        T& operator[](int i0)
+        {
+            return (*this)[index<N>(i0)];
+        }
+
+        const T& operator[](int i0) const
+        {
+            return (*this)[index<N>(i0)];
+        }
+
+        T& operator()(const index<N>& idx)
+        {
+            return (*this)[idx];
+        }
+
+        const T& operator()(const index<N>& idx) const
+        {
+            return (*this)[idx];
+        }
+
+        T* data()
+        {
+            return _M_data.get();
+        }
+
+        const T* data() const
+        {
+            return _M_data.get();
+        }
+
+        template <typename U>
+        array_view<U, 1> reinterpret_as()
+        {
+            array_view<U, 1> view(int((extent.size() * sizeof(T)) / sizeof(U)), reinterpret_cast<U*>(_M_data.get()));
+            view._M_owner = _M_data;
+            return view;
+        }
+
+        template <typename U>
+        array_view<const U, 1> reinterpret_as() const
+        {
+            array_view<const U, 1> view(int((extent.size() * sizeof(T)) / sizeof(U)), reinterpret_cast<const U*>(_M_data.get()));
+            view._M_owner = _M_data;
+            return view;
+        }
+
+        template <int K>
+        array_view<T, K> view_as(const concurrency::extent<K>& ext)
+        {
+            return array_view<T, 1>(*this).view_as(ext);
+        }
+
+        template <int K>
+        array_view<const T, K> view_as(const concurrency::extent<K>& ext) const
+        {
+            return array_view<const T, 1>(*this).view_as(ext);
+        }
+
+        array_view<T, N> section(const index<N>& origin, const concurrency::extent<N>& ext)
+        {
+            return array_view<T, N>(*this).section(origin, ext);
+        }
+
+        array_view<const T, N> section(const index<N>& origin, const concurrency::extent<N>& ext) const
+        {
+            return array_view<const T, N>(*this).section(origin, ext);
+        }
+
+        array_view<T, N> section(int i0, int e0)
+        {
+            return array_view<T, N>(*this).section(i0, e0);
+        }
+
+        array_view<const T, N> section(int i0, int e0) const
+        {
+            return array_view<const T, N>(*this).section(i0, e0);
+        }
+
+        concurrency::extent<N> get_extent() const
+        {
+            return extent;
+        }
+
+        accelerator_view get_accelerator_view() const
+        {
+            return accelerator_view();
+        }
+
+        concurrency::extent<N> extent;
+
+    private:
+        int _Offset(const index<N>& idx) const
+        {
+            assert(extent.contains(idx));
+            int offset = 0;
+            for (int i = 0; i < N; ++i)
+            {
+                offset = (offset * extent[i]) + idx[i];
+            }
+            return offset;
+        }
+
+        std::shared_ptr<T> _M_data;
+    };
+
+    template <typename T, int N>
+    class array_view
+    {
+        template <typename U, int K>
+        friend class array_view;
+
+        template <typename U, int K>
+        friend class array;
+
+        typedef typename std::remove_const<T>::type _Value_type;
+
+    public:
+        static const int rank = N;
+        typedef T value_type;
+
+        array_view(array<_Value_type, N>& src) : extent(src.extent), _M_owner(src._M_data), _M_base(src._M_data.get())
+        {
+            _Init_strides(src.extent);
+        }
+
+        // Like C++ AMP, a view of a temporary array keeps its storage alive.
+        array_view(array<_Value_type, N>&& src) : array_view(src)
+        { }
+
+        template <typename U = T, typename = typename std::enable_if<std::is_const<U>::value>::type>
+        array_view(const array<_Value_type, N>& src) : extent(src.extent), _M_owner(src._M_data), _M_base(src._M_data.get())
+        {
+            _Init_strides(src.extent);
+        }
+
+        array_view(const concurrency::extent<N>& ext, T* src) : extent(ext), _M_base(src)
+        {
+            _Init_strides(ext);
+        }
+
+        array_view(int e0, T* src) : array_view(concurrency::extent<N>(e0), src)
+        { }
+
+        array_view(int e0, int e1, T* src) : array_view(concurrency::extent<N>(e0, e1), src)
+        { }
+
+        template <typename Container, typename = decltype(std::declval<Container&>().data())>
+        array_view(const concurrency::extent<N>& ext, Container& src) : array_view(ext, static_cast<T*>(src.data()))
+        { }
+
+        template <typename Container, typename = decltype(std::declval<Container&>().data())>
+        array_view(int e0, Container& src) : array_view(concurrency::extent<N>(e0), static_cast<T*>(src.data()))
+        { }
+
+        template <typename Container, typename = decltype(std::declval<Container&>().data())>
+        array_view(int e0, int e1, Container& src) : array_view(concurrency::extent<N>(e0, e1), static_cast<T*>(src.data()))
+        { }
+
+        template <typename Container, typename = decltype(std::declval<Container&>().data())>
+        array_view(int e0, int e1, int e2, Container& src) : array_view(concurrency::extent<N>(e0, e1, e2), static_cast<T*>(src.data()))
+        { }
+
+        // Allows an array_view<T> to be used where an array_view<const T> is expected.
+        template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+        array_view(const array_view<U, N>& other) : extent(other.extent), _M_owner(other._M_owner), _M_base(other._M_base)
+        {
+            std::copy(other._M_stride, other._M_stride + N, _M_stride);
+        }
+
+        T& operator[](const index<N>& idx) const
+        {
+            assert(extent.contains(idx));
+            int offset = 0;
+            for (int i = 0; i < N; ++i)
+            {
+                offset += idx[i] * _M_stride[i];
+            }
+            return _M_base[offset];
+        }
+
+        T& operator[](int i0) const
+        {
+            return (*this)[index<N>(i0)];
+        }
+
+        T& operator()(const index<N>& idx) const
+        {
+            return (*this)[idx];
+        }
+
+        T& operator()(int i0) const
+        {
+            return (*this)[index<N>(i0)];
+        }
+
+        T& operator()(int i0, int i1) const
+        {
+            return (*this)[index<N>(i0, i1)];
+        }
+
+        T& operator()(int i0, int i1, int i2) const
+        {
+            return (*this)[index<N>(i0, i1, i2)];
+        }
+
+        array_view section(const index<N>& origin, const concurrency::extent<N>& ext) const
+        {
+            array_view view(*this);
+            view._M_base = &(*this)[origin];
+            view.extent = ext;
+            return view;
+        }
+
+        array_view section(const index<N>& origin) const
+        {
+            concurrency::extent<N> ext(extent);
+            for (int i = 0; i < N; ++i)
+            {
+                ext[i] -= origin[i];
+            }
+            return section(origin, ext);
+        }
+
+        array_view section(const concurrency::extent<N>& ext) const
+        {
+            return section(index<N>(), ext);
+        }
+
+        array_view section(int i0, int e0) const
+        {
+            return section(index<N>(i0), concurrency::extent<N>(e0));
+        }
+
+        template <int K>
+        array_view<T, K> view_as(const concurrency::extent<K>& ext) const
+        {
+            static_assert(N == 1, "Only rank 1 array views can be reshaped.");
+            array_view<T, K> view(ext, _M_base);
+            view._M_owner = _M_owner;
+            return view;
+        }
+
+        T* data() const
+        {
+            static_assert(N == 1, "Only rank 1 array views provide access to their data.");
+            return _M_base;
+        }
+
+        concurrency::extent<N> get_extent() const
+        {
+            return extent;
+        }
+
+        accelerator_view get_source_accelerator_view() const
+        {
+            return accelerator_view();
+        }
+
+        void synchronize() const
+        { }
+
+        void refresh() const
+        { }
+
+        void discard_data() const
+        { }
+
+        concurrency::extent<N> extent;
+
+    private:
+        void _Init_strides(const concurrency::extent<N>& ext)
+        {
+            int stride = 1;
+            for (int i = N - 1; i >= 0; --i)
+            {
+                _M_stride[i] = stride;
+                stride *= ext[i];
+            }
+        }
+
+        std::shared_ptr<void> _M_owner;
+        T* _M_base;
+        int _M_stride[N];
+    };
+
+    //----------------------------------------------------------------------------
+    // copy
+    //----------------------------------------------------------------------------
+
+    namespace details
+    {
+        template <typename T, int N, typename Func>
+        inline void _For_each_element(const array_view<T, N>& view, const Func& func)
+        {
+            const int size = int(view.extent.size());
+            for (int i = 0; i < size; ++i)
+            {
+                func(view[_Linear_to_index(view.extent, i)]);
+            }
+        }
+    }
+
+    template <typename T, int N, typename OutputIterator>
+    inline void copy(const array_view<T, N>& src, OutputIterator dest)
+    {
+        details::_For_each_element(src, [&dest](T& v) { *dest++ = v; });
+    }
+
+    template <typename T, int N, typename OutputIterator>
+    inline void copy(const array<T, N>& src, OutputIterator dest)
+    {
+        std::copy(src.data(), src.data() + src.extent.size(), dest);
+    }
+
+    template <typename InputIterator, typename T, int N>
+    inline void copy(InputIterator first, InputIterator last, const array_view<T, N>& dest)
+    {
+        details::_For_each_element(dest, [&first, &last](T& v) { if (first != last) { v = *first++; } });
+    }
+
+    template <typename InputIterator, typename T, int N>
+    inline void copy(InputIterator first, InputIterator last, array<T, N>& dest)
+    {
+        copy(first, last, array_view<T, N>(dest));
+    }
+
+    template <typename InputIterator, typename T, int N>
+    inline void copy(InputIterator first, array<T, N>& dest)
+    {
+        std::copy(first, first + dest.extent.size(), dest.data());
+    }
+
+    template <typename T, int N>
+    inline void copy(const array_view<const T, N>& src, const array_view<T, N>& dest)
+    {
+        std::vector<T> buffer;
+        buffer.reserve(src.extent.size());
+        copy(src, std::back_inserter(buffer));
+        copy(buffer.begin(), buffer.end(), dest);
+    }
+
+    template <typename T, int N>
+    inline void copy(const array_view<T, N>& src, const array_view<T, N>& dest)
+    {
+        copy(array_view<const T, N>(src), dest);
+    }
+
+    template <typename T, int N>
+    inline void copy(const array<T, N>& src, array<T, N>& dest)
+    {
+        copy(array_view<const T, N>(src), array_view<T, N>(dest));
+    }
+
+    template <typename T, int N>
+    inline void copy(const array<T, N>& src, const array_view<T, N>& dest)
+    {
+        copy(array_view<const T, N>(src), dest);
+    }
+
+    template <typename T, int N>
+    inline void copy(const array_view<const T, N>& src, array<T, N>& dest)
+    {
+        copy(src, array_view<T, N>(dest));
+    }
+
+    template <typename T, int N>
+    inline void copy(const array_view<T, N>& src, array<T, N>& dest)
+    {
+        copy(array_view<const T, N>(src), array_view<T, N>(dest));
+    }
+
+    //----------------------------------------------------------------------------
+    // copy_async
+    //
+    // Kernels and copies complete before they return, so the futures are always ready.
+    //----------------------------------------------------------------------------
+
+    class completion_future
+    {
+    public:
+        completion_future() : _M_future(_Ready())
+        { }
+
+        void get() const
+        {
+            _M_future.get();
+        }
+
+        void wait() const
+        {
+            _M_future.wait();
+        }
+
+        bool valid() const
+        {
+            return _M_future.valid();
+        }
+
+        template <typename Functor>
+        void then(const Functor& func) const
+        {
+            func();
+        }
+
+        operator std::shared_future<void>() const
+        {
+            return _M_future;
+        }
+
+    private:
+        static std::shared_future<void> _Ready()
+        {
+            std::promise<void> ready;
+            ready.set_value();
+            return ready.get_future().share();
+        }
+
+        std::shared_future<void> _M_future;
+    };
+
+    template <typename T, int N, typename OutputIterator>
+    inline completion_future copy_async(const array<T, N>& src, OutputIterator dest)
+    {
+        copy(src, dest);
+        return completion_future();
+    }
+
+    template <typename T, int N, typename OutputIterator>
+    inline completion_future copy_async(const array_view<T, N>& src, OutputIterator dest)
+    {
+        copy(src, dest);
+        return completion_future();
+    }
+
+    //----------------------------------------------------------------------------
+    // atomic operations
+    //----------------------------------------------------------------------------
+
+    namespace details
+    {
+        template <typename T, typename Compare>
+        inline T _Atomic_fetch_select(T* dest, const T value, const Compare& comp)
+        {
+            T current = __atomic_load_n(dest, __ATOMIC_SEQ_CST);
+            while (comp(value, current) && !__atomic_compare_exchange_n(dest, &current, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            { }
+            return current;
+        }
+    }
+
+    inline int atomic_fetch_add(int* dest, int value) { return __atomic_fetch_add(dest, value, __ATOMIC_SEQ_CST); }
+    inline unsigned int atomic_fetch_add(unsigned int* dest, unsigned int value) { return __atomic_fetch_add(dest, value, __ATOMIC_SEQ_CST); }
+    inline int atomic_fetch_sub(int* dest, int value) { return __atomic_fetch_sub(dest, value, __ATOMIC_SEQ_CST); }
+    inline unsigned int atomic_fetch_sub(unsigned int* dest, unsigned int value) { return __atomic_fetch_sub(dest, value, __ATOMIC_SEQ_CST); }
+    inline int atomic_fetch_inc(int* dest) { return atomic_fetch_add(dest, 1); }
+    inline unsigned int atomic_fetch_inc(unsigned int* dest) { return atomic_fetch_add(dest, 1u); }
+    inline int atomic_fetch_dec(int* dest) { return atomic_fetch_sub(dest, 1); }
+    inline unsigned int atomic_fetch_dec(unsigned int* dest) { return atomic_fetch_sub(dest, 1u); }
+    inline int atomic_fetch_and(int* dest, int value) { return __atomic_fetch_and(dest, value, __ATOMIC_SEQ_CST); }
+    inline unsigned int atomic_fetch_and(unsigned int* dest, unsigned int value) { return __atomic_fetch_and(dest, value, __ATOMIC_SEQ_CST); }
+    inline int atomic_fetch_or(int* dest, int value) { return __atomic_fetch_or(dest, value, __ATOMIC_SEQ_CST); }
+    inline unsigned int atomic_fetch_or(unsigned int* dest, unsigned int value) { return __atomic_fetch_or(dest, value, __ATOMIC_SEQ_CST); }
+    inline int atomic_fetch_xor(int* dest, int value) { return __atomic_fetch_xor(dest, value, __ATOMIC_SEQ_CST); }
+    inline unsigned int atomic_fetch_xor(unsigned int* dest, unsigned int value) { return __atomic_fetch_xor(dest, value, __ATOMIC_SEQ_CST); }
+    inline int atomic_exchange(int* dest, int value) { return __atomic_exchange_n(dest, value, __ATOMIC_SEQ_CST); }
+    inline unsigned int atomic_exchange(unsigned int* dest, unsigned int value) { return __atomic_exchange_n(dest, value, __ATOMIC_SEQ_CST); }
+
+    inline float atomic_exchange(float* dest, float value)
+    {
+        float previous;
+        __atomic_exchange(dest, &value, &previous, __ATOMIC_SEQ_CST);
+        return previous;
+    }
+
+    inline bool atomic_compare_exchange(int* dest, int* expected_value, int value)
+    {
+        return __atomic_compare_exchange_n(dest, expected_value, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+
+    inline bool atomic_compare_exchange(unsigned int* dest, unsigned int* expected_value, unsigned int value)
+    {
+        return __atomic_compare_exchange_n(dest, expected_value, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+
+    inline int atomic_fetch_min(int* dest, int value) { return details::_Atomic_fetch_select(dest, value, std::less<int>()); }
+    inline unsigned int atomic_fetch_min(unsigned int* dest, unsigned int value) { return details::_Atomic_fetch_select(dest, value, std::less<unsigned int>()); }
+    inline int atomic_fetch_max(int* dest, int value) { return details::_Atomic_fetch_select(dest, value, std::greater<int>()); }
+    inline unsigned int atomic_fetch_max(unsigned int* dest, unsigned int value) { return details::_Atomic_fetch_select(dest, value, std::greater<unsigned int>()); }
+
+    namespace direct3d
+    {
+        inline unsigned int asuint(float value)
+        {
+            unsigned int bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline int asint(float value)
+        {
+            int bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline float asfloat(unsigned int value)
+        {
+            float result;
+            std::memcpy(&result, &value, sizeof(result));
+            return result;
+        }
+
+        inline float asfloat(int value)
+        {
+            float result;
+            std::memcpy(&result, &value, sizeof(result));
+            return result;
+        }
+    } // namespace concurrency::direct3d
+} // namespace concurrency
+
+namespace Concurrency = concurrency;
+
+namespace amp_algorithms
+{
+    namespace _details
+    {
+        namespace host
+        {
+            //----------------------------------------------------------------------------
+            // parallel_for_each
+            //----------------------------------------------------------------------------
+
+            // Maps a simple compute domain onto the worker threads in contiguous chunks.
+            template <int N, typename Kernel>
+            void parallel_for_each(const concurrency::extent<N>& compute_domain, const Kernel& kernel)
+            {
+                const int element_count = int(compute_domain.size());
+                if (element_count <= 0)
+                {
+                    return;
+                }
+                host_executor& executor = host_executor::instance();
+                const int chunk_count = std::min(element_count, int(executor.thread_count()) * 4);
+                const int chunk_size = (element_count + chunk_count - 1) / chunk_count;
+
+                executor.run((element_count + chunk_size - 1) / chunk_size, [&](int chunk)
+                {
+                    const int last = std::min(element_count, (chunk + 1) * chunk_size);
+                    for (int i = chunk * chunk_size; i < last; ++i)
+                    {
+                        kernel(concurrency::details::_Linear_to_index(compute_domain, i));
+                    }
+                });
+            }
+
+            // Maps each tile onto a worker thread, which runs the threads of the tile as fibers.
+            template <int D0, int D1, int D2, typename Kernel>
+            void parallel_for_each(const concurrency::tiled_extent<D0, D1, D2>& compute_domain, const Kernel& kernel)
+            {
+                static const int rank = concurrency::tiled_extent<D0, D1, D2>::rank;
+                const concurrency::extent<rank> tile_extent = compute_domain.get_tile_extent();
+
+                concurrency::extent<rank> tile_count_extent;
+                for (int i = 0; i < rank; ++i)
+                {
+                    if ((compute_domain[i] % tile_extent[i]) != 0)
+                    {
+                        throw concurrency::invalid_compute_domain("The compute domain must be evenly divisible by the tile size.");
+                    }
+                    tile_count_extent[i] = compute_domain[i] / tile_extent[i];
+                }
+
+                host_executor::instance().run(int(tile_count_extent.size()), [&](int tile_id)
+                {
+                    const concurrency::index<rank> tile = concurrency::details::_Linear_to_index(tile_count_extent, tile_id);
+                    concurrency::index<rank> tile_origin;
+                    for (int i = 0; i < rank; ++i)
+                    {
+                        tile_origin[i] = tile[i] * tile_extent[i];
+                    }
+
+                    tile_fibers::current().run(int(tile_extent.size()), [&](int lane)
+                    {
+                        const concurrency::index<rank> local = concurrency::details::_Linear_to_index(tile_extent, lane);
+                        kernel(concurrency::tiled_index<D0, D1, D2>(tile_origin + local, local, tile, tile_origin, concurrency::tile_barrier()));
+                    });
+                });
+            }
+        } // namespace amp_algorithms::_details::host
+    } // namespace amp_algorithms::_details
+} // namespace amp_algorithms
+
+namespace concurrency
+{
+    template <int N, typename Kernel>
+    inline void parallel_for_each(const extent<N>& compute_domain, const Kernel& kernel)
+    {
+        amp_algorithms::_details::host::parallel_for_each(compute_domain, kernel);
+    }
+
+    template <int N, typename Kernel>
+    inline void parallel_for_each(const accelerator_view&, const extent<N>& compute_domain, const Kernel& kernel)
+    {
+        amp_algorithms::_details::host::parallel_for_each(compute_domain, kernel);
+    }
+
+    template <int D0, int D1, int D2, typename Kernel>
+    inline void parallel_for_each(const tiled_extent<D0, D1, D2>& compute_domain, const Kernel& kernel)
+    {
+        amp_algorithms::_details::host::parallel_for_each(compute_domain, kernel);
+    }
+
+    template <int D0, int D1, int D2, typename Kernel>
+    inline void parallel_for_each(const accelerator_view&, const tiled_extent<D0, D1, D2>& compute_domain, const Kernel& kernel)
+    {
+        amp_algorithms::_details::host::parallel_for_each(compute_domain, kernel);
+    }
+} // namespace concurrency
+
+// The Visual C++ checked iterator helper used by the library.
+namespace stdext
+{
+    template <typename T>
+    inline T* make_checked_array_iterator(T* const ptr, const size_t /*size*/)
+    {
+        return ptr;
+    }
+}
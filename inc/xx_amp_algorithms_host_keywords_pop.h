@@ -0,0 +1,29 @@
+/*----------------------------------------------------------------------------
+* Copyright (c) Microsoft Corp.
+*
+* Licensed under the Apache License, Version 2.0 (the "License"); you may not
+* use this file except in compliance with the License.  You may obtain a copy
+* of the License at http://www.apache.org/licenses/LICENSE-2.0
+*
+* THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED
+* WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE,
+* MERCHANTABLITY OR NON-INFRINGEMENT.
+*
+* See the Apache Version 2.0 License for specific language governing
+* permissions and limitations under the License.
+*---------------------------------------------------------------------------
+*
+* C++ AMP algorithms library.
+*
+* This file restores restrict and tile_static to their definitions before the
+* matching include of xx_amp_algorithms_host_keywords_push.h. It has no include
+* guard because it is included once by each header.
+*---------------------------------------------------------------------------*/
+
+#if defined(AMP_ALGORITHMS_HOST_BACKEND) && !defined(AMP_ALGORITHMS_HOST_KEYWORDS)
+
+#pragma pop_macro("tile_static")
+#pragma pop_macro("restrict")
+
+#endif
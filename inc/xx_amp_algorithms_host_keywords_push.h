@@ -0,0 +1,39 @@
+/*----------------------------------------------------------------------------
+* Copyright (c) Microsoft Corp.
+*
+* Licensed under the Apache License, Version 2.0 (the "License"); you may not
+* use this file except in compliance with the License.  You may obtain a copy
+* of the License at http://www.apache.org/licenses/LICENSE-2.0
+*
+* THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED
+* WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE,
+* MERCHANTABLITY OR NON-INFRINGEMENT.
+*
+* See the Apache Version 2.0 License for specific language governing
+* permissions and limitations under the License.
+*---------------------------------------------------------------------------
+*
+* C++ AMP algorithms library.
+*
+* This file defines restrict and tile_static for the host execution backend. It
+* is included by each library header after its own includes, and
+* xx_amp_algorithms_host_keywords_pop.h is included at the end of the header, so
+* the definitions do not leak into code that includes the library. It has no
+* include guard because it is included once by each header.
+*---------------------------------------------------------------------------*/
+
+#if defined(AMP_ALGORITHMS_HOST_BACKEND) && !defined(AMP_ALGORITHMS_HOST_KEYWORDS)
+
+// Kernels run as ordinary host code so the restriction specifiers are dropped. All the threads
+// of a tile run as fibers on the same worker thread, so thread local storage gives each tile
+// its own copy of its tile_static variables.
+
+#pragma push_macro("restrict")
+#pragma push_macro("tile_static")
+#undef restrict
+#undef tile_static
+#define restrict(...)
+#define tile_static static thread_local
+
+#endif
@@ -21,12 +21,23 @@
 
 #pragma once
 
+#if defined(_MSC_VER) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
 #include <amp.h>
+#else
+#include <xx_amp_algorithms_host_impl.h>
+#endif
+#include <algorithm>
 #include <assert.h>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 #include <xx_amp_algorithms_impl_inl.h>
 #include <amp_indexable_view.h>
+#include <xx_amp_algorithms_host_keywords_push.h>
 
 namespace amp_algorithms
 {
@@ -34,7 +45,7 @@ namespace amp_algorithms
     {
         inline concurrency::accelerator_view auto_select_target()
         {
-#if _MSC_VER < 1800
+#if defined(_MSC_VER) && (_MSC_VER < 1800) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
             static concurrency::accelerator_view auto_select_accelerator_view = concurrency::accelerator(concurrency::accelerator::cpu_accelerator).create_view();
             return auto_select_accelerator_view;
 #else
@@ -49,7 +60,7 @@ namespace amp_algorithms
         template <int _Rank, typename _Kernel_type>
         void parallel_for_each(const concurrency::accelerator_view &_Accl_view, const concurrency::extent<_Rank>& _Compute_domain, const _Kernel_type &_Kernel)
         {
-#if _MSC_VER < 1800
+#if defined(_MSC_VER) && (_MSC_VER < 1800) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
             _Host_Scheduling_info _SchedulingInfo = { NULL };
             if (_Accl_view != _details::auto_select_target()) 
             {
@@ -65,7 +76,7 @@ namespace amp_algorithms
         template <int _Dim0, int _Dim1, int _Dim2, typename _Kernel_type>
         void parallel_for_each(const concurrency::accelerator_view &_Accl_view, const concurrency::tiled_extent<_Dim0, _Dim1, _Dim2>& _Compute_domain, const _Kernel_type& _Kernel)
         {
-#if _MSC_VER < 1800
+#if defined(_MSC_VER) && (_MSC_VER < 1800) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
             _Host_Scheduling_info _SchedulingInfo = { NULL };
             if (_Accl_view != _details::auto_select_target()) 
             {
@@ -81,7 +92,7 @@ namespace amp_algorithms
         template <int _Dim0, int _Dim1, typename _Kernel_type>
         void parallel_for_each(const concurrency::accelerator_view &_Accl_view, const concurrency::tiled_extent<_Dim0, _Dim1>& _Compute_domain, const _Kernel_type& _Kernel)
         {
-#if _MSC_VER < 1800
+#if defined(_MSC_VER) && (_MSC_VER < 1800) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
             _Host_Scheduling_info _SchedulingInfo = { NULL };
             if (_Accl_view != _details::auto_select_target()) 
             {
@@ -97,7 +108,7 @@ namespace amp_algorithms
         template <int _Dim0, typename _Kernel_type>
         void parallel_for_each(const concurrency::accelerator_view &_Accl_view, const concurrency::tiled_extent<_Dim0>& _Compute_domain, const _Kernel_type& _Kernel)
         {
-#if _MSC_VER < 1800
+#if defined(_MSC_VER) && (_MSC_VER < 1800) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
             _Host_Scheduling_info _SchedulingInfo = { NULL };
             if (_Accl_view != _details::auto_select_target()) 
             {
@@ -110,6 +121,150 @@ namespace amp_algorithms
 #endif
         }
 
+        //----------------------------------------------------------------------------
+        // scratch buffers
+        //----------------------------------------------------------------------------
+
+        // Temporary buffers used by the algorithms are taken from a pool for each accelerator_view rather than being
+        // allocated on every call. Buffers are kept in power of 2 size classes so a buffer can be reused for any request
+        // in the same class. Commands on an accelerator_view execute in order, so a buffer can be returned to the pool as
+        // soon as the commands that use it have been submitted. The contents of a buffer are undefined when acquired.
+        //
+        // Only the most recently used accelerator_views keep a pool, so views created for a single call do not keep their
+        // queue and buffers alive for the life of the process.
+        class scratch_pool
+        {
+        public:
+            typedef concurrency::array<unsigned int, 1> buffer_type;
+
+            static scratch_pool& instance()
+            {
+                static scratch_pool pool;
+                return pool;
+            }
+
+            std::shared_ptr<buffer_type> acquire(const concurrency::accelerator_view& accl_view, unsigned int word_count)
+            {
+                const unsigned int size_class = size_class_of(word_count);
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    std::vector<std::shared_ptr<buffer_type>>& bucket = buckets(accl_view)[size_class];
+                    if (!bucket.empty())
+                    {
+                        std::shared_ptr<buffer_type> buffer = bucket.back();
+                        bucket.pop_back();
+                        return buffer;
+                    }
+                }
+                return std::make_shared<buffer_type>(int(1u << size_class), accl_view);
+            }
+
+            void release(const concurrency::accelerator_view& accl_view, const std::shared_ptr<buffer_type>& buffer)
+            {
+                const unsigned int size_class = size_class_of(buffer->extent.size());
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::vector<std::shared_ptr<buffer_type>>& bucket = buckets(accl_view)[size_class];
+                if (bucket.size() < max_buffers_per_size_class)
+                {
+                    bucket.push_back(buffer);
+                }
+            }
+
+            // Frees all the buffers that are not in use.
+            void clear()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pools.clear();
+            }
+
+        private:
+            static const unsigned int min_size_class = 8;
+            static const unsigned int size_class_count = 31;
+            static const size_t max_buffers_per_size_class = 4;
+            static const size_t max_view_pools = 4;
+
+            typedef std::vector<std::shared_ptr<buffer_type>> bucket_array[size_class_count];
+
+            struct view_pool
+            {
+                explicit view_pool(const concurrency::accelerator_view& view) : accl_view(view)
+                {
+                }
+
+                concurrency::accelerator_view accl_view;
+                bucket_array buckets;
+            };
+
+            scratch_pool()
+            {
+            }
+
+            scratch_pool(const scratch_pool&);
+            scratch_pool& operator=(const scratch_pool&);
+
+            static unsigned int size_class_of(unsigned int word_count)
+            {
+                unsigned int size_class = min_size_class;
+                while ((size_class < (size_class_count - 1)) && ((1u << size_class) < word_count))
+                {
+                    ++size_class;
+                }
+                return size_class;
+            }
+
+            // The pools are kept in most recently used order, the least recently used pool is freed to make room for a new one.
+            bucket_array& buckets(const concurrency::accelerator_view& accl_view)
+            {
+                auto pool = std::find_if(m_pools.begin(), m_pools.end(), [&](const std::shared_ptr<view_pool>& p) { return p->accl_view == accl_view; });
+                if (pool == m_pools.end())
+                {
+                    if (m_pools.size() >= max_view_pools)
+                    {
+                        m_pools.pop_back();
+                    }
+                    pool = m_pools.insert(m_pools.end(), std::make_shared<view_pool>(accl_view));
+                }
+                std::rotate(m_pools.begin(), pool, pool + 1);
+                return m_pools.front()->buckets;
+            }
+
+            std::mutex m_mutex;
+            std::vector<std::shared_ptr<view_pool>> m_pools;
+        };
+
+        // A temporary buffer of size elements of T, which is returned to the pool when it is destroyed.
+        template <typename T>
+        class scratch_buffer
+        {
+            static_assert((sizeof(T) % sizeof(unsigned int)) == 0, "The size of T must be a multiple of 4 bytes.");
+
+        public:
+            scratch_buffer(const concurrency::accelerator_view& accl_view, int size) :
+                m_accl_view(accl_view),
+                m_size(size),
+                m_buffer(scratch_pool::instance().acquire(accl_view, std::max(1u, unsigned(size) * unsigned(sizeof(T) / sizeof(unsigned int)))))
+            {
+            }
+
+            ~scratch_buffer()
+            {
+                scratch_pool::instance().release(m_accl_view, m_buffer);
+            }
+
+            concurrency::array_view<T, 1> view() const
+            {
+                return m_buffer->template reinterpret_as<T>().section(0, m_size);
+            }
+
+        private:
+            scratch_buffer(const scratch_buffer&);
+            scratch_buffer& operator=(const scratch_buffer&);
+
+            concurrency::accelerator_view m_accl_view;
+            int m_size;
+            std::shared_ptr<scratch_pool::buffer_type> m_buffer;
+        };
+
         //----------------------------------------------------------------------------
         // reduce implementation
         //---------------------------------------------------------------------------- 
@@ -119,7 +274,7 @@ namespace amp_algorithms
         // The output (reduced result) is contained in "mem[0]" at the end of this function
         // The parameter "partial_data_length" is used to indicate if the size of data in "mem" to be
         // reduced is same as the tile size and if not what is the length of valid data in "mem".
-        template <typename T, unsigned int tile_size, typename functor>
+        template <typename T, int tile_size, typename functor>
         void tile_local_reduction(T* const mem, concurrency::tiled_index<tile_size> tid, const functor& op, int partial_data_length) restrict(amp)
         {
             // local index
@@ -128,16 +283,16 @@ namespace amp_algorithms
             if (partial_data_length < tile_size)
             {
                 // unrolled for performance
-                if (partial_data_length >  512) { if (local < (partial_data_length - 512)) { mem[0] = op(mem[0], mem[512]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >  256) { if (local < (partial_data_length - 256)) { mem[0] = op(mem[0], mem[256]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >  128) { if (local < (partial_data_length - 128)) { mem[0] = op(mem[0], mem[128]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >   64) { if (local < (partial_data_length - 64)) { mem[0] = op(mem[0], mem[64]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >   32) { if (local < (partial_data_length - 32)) { mem[0] = op(mem[0], mem[32]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >   16) { if (local < (partial_data_length - 16)) { mem[0] = op(mem[0], mem[16]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >    8) { if (local < (partial_data_length - 8)) { mem[0] = op(mem[0], mem[8]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >    4) { if (local < (partial_data_length - 4)) { mem[0] = op(mem[0], mem[4]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >    2) { if (local < (partial_data_length - 2)) { mem[0] = op(mem[0], mem[2]); } tid.barrier.wait_with_tile_static_memory_fence(); }
-                if (partial_data_length >    1) { if (local < (partial_data_length - 1)) { mem[0] = op(mem[0], mem[1]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >  512) { if ((local < 512) && (local + 512 < partial_data_length)) { mem[0] = op(mem[0], mem[512]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >  256) { if ((local < 256) && (local + 256 < partial_data_length)) { mem[0] = op(mem[0], mem[256]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >  128) { if ((local < 128) && (local + 128 < partial_data_length)) { mem[0] = op(mem[0], mem[128]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >   64) { if ((local < 64) && (local + 64 < partial_data_length)) { mem[0] = op(mem[0], mem[64]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >   32) { if ((local < 32) && (local + 32 < partial_data_length)) { mem[0] = op(mem[0], mem[32]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >   16) { if ((local < 16) && (local + 16 < partial_data_length)) { mem[0] = op(mem[0], mem[16]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >    8) { if ((local < 8) && (local + 8 < partial_data_length)) { mem[0] = op(mem[0], mem[8]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >    4) { if ((local < 4) && (local + 4 < partial_data_length)) { mem[0] = op(mem[0], mem[4]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >    2) { if ((local < 2) && (local + 2 < partial_data_length)) { mem[0] = op(mem[0], mem[2]); } tid.barrier.wait_with_tile_static_memory_fence(); }
+                if (partial_data_length >    1) { if ((local < 1) && (local + 1 < partial_data_length)) { mem[0] = op(mem[0], mem[1]); } tid.barrier.wait_with_tile_static_memory_fence(); }
             }
             else
             {
@@ -155,28 +310,41 @@ namespace amp_algorithms
             }
         }
 
-        // Generic reduction of a 1D indexable view with a reduction binary functor
+        // Reductions launch at most reduce_max_tiles tiles of reduce_tile_size threads. Larger inputs are folded by
+        // each thread before the tile reduces them.
+        static const int reduce_tile_size = 512;
+        static const int reduce_max_tiles = 10000;
+
+        // Generic reduction of transform_op(i) for i in [0, n) with a reduction binary functor. The result is written to
+        // result_view[0] on the accelerator.
+        //
+        // Each tile folds a strided part of the input and writes its partial result. The last tile to finish, found
+        // with an atomic counter, then reduces the partial results, so the reduction runs in a single kernel and only
+        // the result is copied back to the host.
         template<unsigned int tile_size,
             unsigned int max_tiles,
-            typename InputIndexableView,
-            typename BinaryFunction>
-            typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type
-            reduce(const concurrency::accelerator_view &accl_view, const InputIndexableView &input_view, const BinaryFunction &binary_op)
+            typename TransformFunction,
+            typename BinaryFunction,
+            typename result_type>
+            void transform_reduce_to(const concurrency::accelerator_view &accl_view, const int n, const TransformFunction &transform_op, const BinaryFunction &binary_op, const concurrency::array_view<result_type, 1>& result_view)
         {
-                // The input view must be of rank 1
-                static_assert(indexable_view_traits<InputIndexableView>::rank == 1, "The input indexable view must be of rank 1");
-                typedef typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type result_type;
-
-                // runtime sizes
-                int n = input_view.extent.size();
                 unsigned int tile_count = (n + tile_size - 1) / tile_size;
                 tile_count = std::min(tile_count, max_tiles);
 
                 // simultaneous live threads
                 const unsigned int thread_count = tile_count * tile_size;
 
-                // global buffer (return type)
-                concurrency::array_view<result_type> global_buffer_view(concurrency::array<result_type>(tile_count, concurrency::accelerator(concurrency::accelerator::cpu_accelerator).default_view, accl_view));
+                // partial results of each tile and the number of tiles that have written them
+                scratch_buffer<result_type> partials(accl_view, tile_count);
+                scratch_buffer<unsigned int> tiles_done(accl_view, 1);
+                concurrency::array_view<result_type, 1> partials_view = partials.view();
+                concurrency::array_view<unsigned int, 1> tiles_done_view = tiles_done.view();
+
+                // scratch buffers are reused, so the counter is reset on the accelerator
+                _details::parallel_for_each(accl_view, tiles_done_view.extent, [=](concurrency::index<1> idx) restrict(amp)
+                {
+                    tiles_done_view[idx] = 0;
+                });
 
                 // configuration
                 concurrency::extent<1> extent(thread_count);
@@ -188,6 +356,7 @@ namespace amp_algorithms
                 {
                     // shared tile buffer
                     tile_static result_type local_buffer[tile_size];
+                    tile_static int is_last_tile;
 
                     int idx = tid.global[0];
 
@@ -197,8 +366,11 @@ namespace amp_algorithms
                     // this variable is used to test if we are on the edge of data within tile
                     int partial_data_length = n - tid.tile[0] * tile_size;
 
-                    // initialize local buffer
-                    smem = input_view[concurrency::index<1>(idx)];
+                    // initialize local buffer, threads beyond the end of the data are excluded by tile_local_reduction
+                    if (idx < n)
+                    {
+                        smem = transform_op(idx);
+                    }
                     // next chunk
                     idx += thread_count;
 
@@ -206,7 +378,7 @@ namespace amp_algorithms
                     while (idx < n)
                     {
                         // reduction of smem and X[idx] with results stored in smem
-                        smem = binary_op(smem, input_view[concurrency::index<1>(idx)]);
+                        smem = binary_op(smem, transform_op(idx));
 
                         // next chunk
                         idx += thread_count;
@@ -222,20 +394,109 @@ namespace amp_algorithms
                     if (tid.local[0] == 0)
                     {
                         // write to global buffer in this tiles
-                        global_buffer_view[tid.tile[0]] = smem;
+                        partials_view[tid.tile[0]] = smem;
+                        concurrency::global_memory_fence(tid.barrier);
+                        is_last_tile = (concurrency::atomic_fetch_inc(&tiles_done_view[0]) == (tile_count - 1)) ? 1 : 0;
+                    }
+                    tid.barrier.wait_with_all_memory_fence();
+
+                    // 2nd pass reduction, the partial results of all the tiles are visible to the last tile
+                    if (is_last_tile != 0)
+                    {
+                        idx = tid.local[0];
+                        if (idx < int(tile_count))
+                        {
+                            smem = partials_view[idx];
+                        }
+                        for (idx += tile_size; idx < int(tile_count); idx += tile_size)
+                        {
+                            smem = binary_op(smem, partials_view[idx]);
+                        }
+                        tid.barrier.wait_with_tile_static_memory_fence();
+
+                        _details::tile_local_reduction(&smem, tid, binary_op, int(tile_count));
+
+                        if (tid.local[0] == 0)
+                        {
+                            result_view[0] = smem;
+                        }
                     }
                 });
+        }
 
-                // 2nd pass reduction
-                result_type *pGlobalBufferViewData = global_buffer_view.data();
-                result_type retVal = pGlobalBufferViewData[0];
-                for (unsigned int i = 1; i < tile_count; ++i) {
-                    retVal = binary_op(retVal, pGlobalBufferViewData[i]);
-                }
+        template<unsigned int tile_size,
+            unsigned int max_tiles,
+            typename InputIndexableView,
+            typename BinaryFunction,
+            typename result_type>
+            void reduce_to(const concurrency::accelerator_view &accl_view, const InputIndexableView &input_view, const BinaryFunction &binary_op, const concurrency::array_view<result_type, 1>& result_view)
+        {
+                // The input view must be of rank 1
+                static_assert(indexable_view_traits<InputIndexableView>::rank == 1, "The input indexable view must be of rank 1");
+
+                transform_reduce_to<tile_size, max_tiles>(accl_view, int(input_view.extent.size()),
+                    [=](const int idx) restrict(amp) { return input_view[concurrency::index<1>(idx)]; }, binary_op, result_view);
+        }
+
+        // Returns the reduction of transform_op(i) for i in [0, n), which must not be empty.
+        template<unsigned int tile_size,
+            unsigned int max_tiles,
+            typename TransformFunction,
+            typename BinaryFunction>
+            typename std::result_of<TransformFunction(int)>::type
+            transform_reduce(const concurrency::accelerator_view &accl_view, const int n, const TransformFunction &transform_op, const BinaryFunction &binary_op)
+        {
+                typedef typename std::result_of<TransformFunction(int)>::type result_type;
 
+                scratch_buffer<result_type> result(accl_view, 1);
+                transform_reduce_to<tile_size, max_tiles>(accl_view, n, transform_op, binary_op, result.view());
+
+                result_type retVal;
+                concurrency::copy(result.view(), &retVal);
+                return retVal;
+        }
+
+        template<unsigned int tile_size,
+            unsigned int max_tiles,
+            typename InputIndexableView,
+            typename BinaryFunction>
+            typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type
+            reduce(const concurrency::accelerator_view &accl_view, const InputIndexableView &input_view, const BinaryFunction &binary_op)
+        {
+                typedef typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type result_type;
+
+                scratch_buffer<result_type> result(accl_view, 1);
+                reduce_to<tile_size, max_tiles>(accl_view, input_view, binary_op, result.view());
+
+                result_type retVal;
+                concurrency::copy(result.view(), &retVal);
                 return retVal;
         }
 
+        // Returns without waiting for the reduction, the future becomes ready once the result has been copied back.
+        template<unsigned int tile_size,
+            unsigned int max_tiles,
+            typename InputIndexableView,
+            typename BinaryFunction>
+            std::future<typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type>
+            reduce_async(const concurrency::accelerator_view &accl_view, const InputIndexableView &input_view, const BinaryFunction &binary_op)
+        {
+                typedef typename std::result_of<BinaryFunction(const typename indexable_view_traits<InputIndexableView>::value_type&, const typename indexable_view_traits<InputIndexableView>::value_type&)>::type result_type;
+
+                auto result = std::make_shared<scratch_buffer<result_type>>(accl_view, 1);
+                reduce_to<tile_size, max_tiles>(accl_view, input_view, binary_op, result->view());
+
+                // The continuation keeps the result and the value it is copied to alive until the copy completes.
+                auto value = std::make_shared<result_type>();
+                auto promise = std::make_shared<std::promise<result_type>>();
+                concurrency::completion_future copied = concurrency::copy_async(result->view(), value.get());
+                copied.then([result, value, promise]()
+                {
+                    promise->set_value(*value);
+                });
+                return promise->get_future();
+        }
+
         //----------------------------------------------------------------------------
         // scan implementation
         //----------------------------------------------------------------------------
@@ -249,41 +510,69 @@ namespace amp_algorithms
         static const int scan_default_tile_size = 512;
 #endif
 
+        // Inputs with at most this many elements are scanned by a single tile, which loops over the input. This needs one
+        // kernel and no temporary arrays, which is faster for small inputs than scanning the tiles in parallel.
+#ifndef AMP_ALGORITHMS_SCAN_SINGLE_TILE_THRESHOLD
+#define AMP_ALGORITHMS_SCAN_SINGLE_TILE_THRESHOLD 4096
+#endif
+        static const int scan_single_tile_threshold = AMP_ALGORITHMS_SCAN_SINGLE_TILE_THRESHOLD;
+
+        // Threads in a warp execute in lock step on the accelerator, so each step reads the values
+        // written by the previous step without synchronization. The host backend runs the threads of a
+        // tile independently, so all the threads of a warp read before any of them write.
+        template <typename _BinaryOp, typename T>
+        inline void scan_warp_step(T* const tile_data, const int idx, const int offset, const _BinaryOp& op) restrict(amp)
+        {
+#if defined(AMP_ALGORITHMS_HOST_BACKEND)
+            const T value = op(tile_data[idx - offset], tile_data[idx]);
+            _details::host::warp_sync();
+            tile_data[idx] = value;
+            _details::host::warp_sync();
+#else
+            tile_data[idx] = op(tile_data[idx - offset], tile_data[idx]);
+#endif
+        }
+
         template <amp_algorithms::scan_mode _Mode, typename _BinaryOp, typename T>
-        T scan_warp(T* const tile_data, const int idx, const _BinaryOp& op) restrict(amp)
+        T scan_warp(T* const tile_data, const int idx, const _BinaryOp& op, const T& identity) restrict(amp)
         {
             const int warp_max = _details::scan_warp_size - 1;
             const int widx = idx & warp_max;
 
             if (widx >= 1)
-                tile_data[idx] = op(tile_data[idx - 1], tile_data[idx]);
+                scan_warp_step(tile_data, idx, 1, op);
             if ((scan_warp_size > 2) && (widx >= 2))
-                tile_data[idx] = op(tile_data[idx - 2], tile_data[idx]);
+                scan_warp_step(tile_data, idx, 2, op);
             if ((scan_warp_size > 4) && (widx >= 4))
-                tile_data[idx] = op(tile_data[idx - 4], tile_data[idx]);
+                scan_warp_step(tile_data, idx, 4, op);
             if ((scan_warp_size > 8) && (widx >= 8))
-                tile_data[idx] = op(tile_data[idx - 8], tile_data[idx]);
+                scan_warp_step(tile_data, idx, 8, op);
             if ((scan_warp_size > 16) && (widx >= 16))
-                tile_data[idx] = op(tile_data[idx - 16], tile_data[idx]);
+                scan_warp_step(tile_data, idx, 16, op);
             if ((scan_warp_size > 32) && (widx >= 32))
-                tile_data[idx] = op(tile_data[idx - 32], tile_data[idx]);
+                scan_warp_step(tile_data, idx, 32, op);
 
             if (_Mode == scan_mode::inclusive)
                 return tile_data[idx];
-            return (widx > 0) ? tile_data[idx - 1] : T();
+            return (widx > 0) ? tile_data[idx - 1] : identity;
         }
 
+        // Scans the TileSize elements of tile_data in place using op. The identity of op is the result of an exclusive
+        // scan for the first element. Relies on the threads of a warp executing in lock step.
         template <int TileSize, scan_mode _Mode, typename _BinaryOp, typename T>
-        T scan_tile(T* const tile_data, concurrency::tiled_index<TileSize> tidx, const _BinaryOp& op) restrict(amp)
+        T scan_tile_warp(T* const tile_data, concurrency::tiled_index<TileSize> tidx, const _BinaryOp& op, const T& identity) restrict(amp)
         {
             static_assert(is_power_of_two<scan_warp_size>::value, "Warp size must be an exact power of 2.");
+            static_assert(TileSize >= _details::scan_warp_size, "Tile size must be at least the size of a single warp.");
+            static_assert(TileSize % _details::scan_warp_size == 0, "Tile size must be an exact multiple of warp size.");
+            static_assert(TileSize <= (_details::scan_warp_size * _details::scan_warp_size), "Tile size must less than or equal to the square of the warp size.");
 
             const int warp_max = _details::scan_warp_size - 1;
             const int lidx = tidx.local[0];
             const int warp_id = lidx >> log2<scan_warp_size>::value;
 
             // Step 1: Intra-warp scan in each warp
-            auto val = scan_warp<_Mode, _BinaryOp>(tile_data, lidx, op);
+            auto val = scan_warp<_Mode, _BinaryOp>(tile_data, lidx, op, identity);
             tidx.barrier.wait_with_tile_static_memory_fence();
 
             // Step 2: Collect per-warp partial results
@@ -293,7 +582,7 @@ namespace amp_algorithms
 
             // Step 3: Use 1st warp to scan per-warp results
             if (warp_id == 0)
-                scan_warp<scan_mode::inclusive>(tile_data, lidx, op);
+                scan_warp<scan_mode::inclusive>(tile_data, lidx, op, identity);
             tidx.barrier.wait_with_tile_static_memory_fence();
 
             // Step 4: Accumulate results from Steps 1 and 3
@@ -307,68 +596,1310 @@ namespace amp_algorithms
             return val;
         }
 
-        template <int TileSize, scan_mode _Mode, typename _BinaryFunc, typename InputIndexableView>
-        inline void scan(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view, const _BinaryFunc& op)
+        // Work efficient tile scan using only tile barriers, so it does not depend on the warp size or on the threads
+        // of a warp executing in lock step. An up-sweep builds a tree of partial reductions in tile_data and a
+        // down-sweep turns it into an exclusive scan, see:
+        //
+        // "Prefix Sums and Their Applications" http://www.cs.cmu.edu/~guyb/papers/Ble93.pdf
+        template <int TileSize, scan_mode _Mode, typename _BinaryOp, typename T>
+        T scan_tile_tree(T* const tile_data, concurrency::tiled_index<TileSize> tidx, const _BinaryOp& op, const T& identity) restrict(amp)
         {
-            static_assert(TileSize >= _details::scan_warp_size, "Tile size must be at least the size of a single warp.");
-            static_assert(TileSize % _details::scan_warp_size == 0, "Tile size must be an exact multiple of warp size.");
-            static_assert(TileSize <= (_details::scan_warp_size * _details::scan_warp_size), "Tile size must less than or equal to the square of the warp size.");
-            assert(output_view.extent[0] >= _details::scan_warp_size);
+            static_assert(is_power_of_two<TileSize>::value, "Tile size must be an exact power of 2.");
+
+            const int lidx = tidx.local[0];
+            const T input = tile_data[lidx];
+
+            // Up-sweep: reduce pairs of sub-trees, leaving the reduction of the whole tile in the last element.
+            for (int stride = 1; stride < TileSize; stride *= 2)
+            {
+                tidx.barrier.wait_with_tile_static_memory_fence();
+                const int right = (lidx + 1) * stride * 2 - 1;
+                if (right < TileSize)
+                    tile_data[right] = op(tile_data[right - stride], tile_data[right]);
+            }
+            tidx.barrier.wait_with_tile_static_memory_fence();
+
+            // Down-sweep: replace the root with the identity and push the prefix of each sub-tree down to its children.
+            if (lidx == 0)
+                tile_data[TileSize - 1] = identity;
+            for (int stride = TileSize / 2; stride >= 1; stride /= 2)
+            {
+                tidx.barrier.wait_with_tile_static_memory_fence();
+                const int right = (lidx + 1) * stride * 2 - 1;
+                if (right < TileSize)
+                {
+                    const T left = tile_data[right - stride];
+                    tile_data[right - stride] = tile_data[right];
+                    tile_data[right] = op(tile_data[right], left);
+                }
+            }
+            tidx.barrier.wait_with_tile_static_memory_fence();
+
+            const T val = (_Mode == scan_mode::exclusive) ? tile_data[lidx] : op(tile_data[lidx], input);
+            tidx.barrier.wait_with_tile_static_memory_fence();
+            tile_data[lidx] = val;
+            tidx.barrier.wait_with_tile_static_memory_fence();
+            return val;
+        }
+
+        // The warp synchronous tile scan is used unless AMP_ALGORITHMS_SCAN_TILE_TREE is defined. The tree scan is correct on
+        // any accelerator and supports any power of 2 tile size.
+        template <int TileSize, scan_mode _Mode, typename _BinaryOp, typename T>
+        T scan_tile(T* const tile_data, concurrency::tiled_index<TileSize> tidx, const _BinaryOp& op, const T& identity) restrict(amp)
+        {
+#if defined(AMP_ALGORITHMS_SCAN_TILE_TREE)
+            return _details::scan_tile_tree<TileSize, _Mode>(tile_data, tidx, op, identity);
+#else
+            return _details::scan_tile_warp<TileSize, _Mode>(tile_data, tidx, op, identity);
+#endif
+        }
+
+        // A backward scan is a forward scan of the elements in reverse order. The tiles read and write the elements at
+        // reversed indices, so no extra reversal pass is needed, and the operands are swapped so the results are
+        // op(x[i], op(x[i + 1], ...)) for operators that are not commutative.
+        template <scan_direction _Direction>
+        inline int scan_index(const int idx, const int size) restrict(cpu, amp)
+        {
+            return (_Direction == scan_direction::forward) ? idx : (size - 1 - idx);
+        }
+
+        template <scan_direction _Direction, typename _BinaryFunc>
+        class scan_direction_op
+        {
+        public:
+            scan_direction_op(const _BinaryFunc& op) restrict(cpu, amp) : m_op(op)
+            {
+            }
+
+            template <typename T>
+            T operator()(const T& a, const T& b) const restrict(cpu, amp)
+            {
+                return (_Direction == scan_direction::forward) ? m_op(a, b) : m_op(b, a);
+            }
+
+        private:
+            _BinaryFunc m_op;
+        };
 
-            typedef InputIndexableView::value_type T;
+        // Multi pass scan. Scans each tile and stores the tile totals, scans the tile totals, recursively if there are
+        // more tiles than fit in a single tile, and then combines the scanned totals with the elements of each tile.
+        // scan_op has already had its operands swapped for a backward scan.
+        template <int TileSize, scan_mode _Mode, scan_direction _Direction, typename _BinaryFunc, typename InputIndexableView>
+        inline void scan_multi_pass_impl(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view, const _BinaryFunc& scan_op,
+            const typename InputIndexableView::value_type& identity)
+        {
+            typedef typename InputIndexableView::value_type T;
 
-            auto compute_domain = output_view.extent.tile<TileSize>().pad();
-            concurrency::array<T, 1> tile_results(compute_domain / TileSize, accl_view);
-            concurrency::array_view<T, 1> tile_results_vw(tile_results);
+            const int size = output_view.extent[0];
+            if (size == 0)
+                return;
+            auto compute_domain = output_view.extent.template tile<TileSize>().pad();
+            scratch_buffer<T> tile_results(accl_view, compute_domain[0] / TileSize);
+            concurrency::array_view<T, 1> tile_results_vw = tile_results.view();
             // 1 & 2. Scan all tiles and store results in tile_results.
-            concurrency::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
             {
                 const int gidx = tidx.global[0];
                 const int lidx = tidx.local[0];
                 tile_static T tile_data[TileSize];
-                tile_data[lidx] = padded_read(input_view, gidx);
+                const T input = (gidx < size) ? input_view[scan_index<_Direction>(gidx, size)] : identity;
+                tile_data[lidx] = input;
                 tidx.barrier.wait_with_tile_static_memory_fence();
 
-                auto val = _details::scan_tile<TileSize, _Mode>(tile_data, tidx, amp_algorithms::plus<T>());
+                auto val = _details::scan_tile<TileSize, _Mode>(tile_data, tidx, scan_op, identity);
                 if (lidx == (TileSize - 1))
                 {
-                    tile_results_vw[tidx.tile[0]] = val;
-                    if (_Mode == scan_mode::exclusive)
-                        tile_results_vw[tidx.tile[0]] += input_view[gidx];
+                    tile_results_vw[tidx.tile[0]] = (_Mode == scan_mode::exclusive) ? scan_op(val, input) : val;
                 }
-                padded_write(output_view, gidx, tile_data[lidx]);
+                if (gidx < size)
+                    output_view[scan_index<_Direction>(gidx, size)] = tile_data[lidx];
             });
 
             // 3. Scan tile results.
             if (tile_results_vw.extent[0] > TileSize)
             {
-                scan<TileSize, amp_algorithms::scan_mode::exclusive>(accl_view, tile_results_vw, tile_results_vw, op);
+                _details::scan_multi_pass_impl<TileSize, amp_algorithms::scan_mode::exclusive, scan_direction::forward>(accl_view, tile_results_vw, tile_results_vw, scan_op, identity);
             }
             else
             {
-                concurrency::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+                _details::parallel_for_each(accl_view, tile_results_vw.extent.template tile<TileSize>().pad(), [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
                 {
                     const int gidx = tidx.global[0];
                     const int lidx = tidx.local[0];
                     tile_static T tile_data[TileSize];
-                    tile_data[lidx] = tile_results_vw[gidx];
+                    tile_data[lidx] = (gidx < tile_results_vw.extent[0]) ? tile_results_vw[gidx] : identity;
                     tidx.barrier.wait_with_tile_static_memory_fence();
 
-                    _details::scan_tile<TileSize, amp_algorithms::scan_mode::exclusive>(tile_data, tidx, amp_algorithms::plus<T>());
+                    _details::scan_tile<TileSize, amp_algorithms::scan_mode::exclusive>(tile_data, tidx, scan_op, identity);
 
-                    tile_results_vw[gidx] = tile_data[lidx];
+                    padded_write(tile_results_vw, gidx, tile_data[lidx]);
                     tidx.barrier.wait_with_tile_static_memory_fence();
                 });
             }
-            // 4. Add the tile results to the individual results for each tile.
-            concurrency::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            // 4. Combine the tile results with the individual results for each tile.
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
             {
                 const int gidx = tidx.global[0];
-                if (gidx < output_view.extent[0])
-                    output_view[gidx] += tile_results_vw[tidx.tile[0]];
+                if (gidx < size)
+                {
+                    const int idx = scan_index<_Direction>(gidx, size);
+                    output_view[idx] = scan_op(tile_results_vw[tidx.tile[0]], output_view[idx]);
+                }
             });
         }
 
-    } // namespace amp_algorithms::_details
+        template <int TileSize, scan_mode _Mode, scan_direction _Direction = scan_direction::forward, typename _BinaryFunc, typename InputIndexableView>
+        inline void scan_multi_pass(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view, const _BinaryFunc& op,
+            const typename InputIndexableView::value_type& identity)
+        {
+            _details::scan_multi_pass_impl<TileSize, _Mode, _Direction>(accl_view, input_view, output_view, scan_direction_op<_Direction, _BinaryFunc>(op), identity);
+        }
 
-} // namespace amp_algorithms
+        // Status of each tile in the single pass scan. A tile publishes its aggregate, the reduction of its own
+        // elements, and then its inclusive prefix, the reduction of all the elements up to and including its own.
+        static const unsigned int scan_tile_status_invalid = 0;
+        static const unsigned int scan_tile_status_aggregate = 1;
+        static const unsigned int scan_tile_status_prefix = 2;
+
+        // Scans the input with a single tile, which scans TileSize elements at a time and carries the total of the
+        // elements scanned so far into the next TileSize elements. Used for small inputs.
+        template <int TileSize, scan_mode _Mode, typename T, typename _BinaryFunc, typename _Load, typename _Store>
+        inline void scan_single_tile(const concurrency::accelerator_view& accl_view, const int size, const _Load& load, const _Store& store, const _BinaryFunc& scan_op,
+            const T& identity)
+        {
+            if (size == 0)
+                return;
+
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(TileSize).template tile<TileSize>();
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                const int lidx = tidx.local[0];
+                tile_static T tile_data[TileSize];
+                tile_static T tile_prefix;
+
+                if (lidx == 0)
+                {
+                    tile_prefix = identity;
+                }
+
+                for (int offset = 0; offset < size; offset += TileSize)
+                {
+                    const int gidx = offset + lidx;
+                    const T input = (gidx < size) ? load(gidx) : identity;
+                    tile_data[lidx] = input;
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+
+                    const T val = _details::scan_tile<TileSize, _Mode>(tile_data, tidx, scan_op, identity);
+                    const T prefix = tile_prefix;
+                    if (gidx < size)
+                        store(gidx, scan_op(prefix, val));
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+
+                    if (lidx == (TileSize - 1))
+                    {
+                        tile_prefix = scan_op(prefix, (_Mode == scan_mode::exclusive) ? scan_op(val, input) : val);
+                    }
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+                }
+            });
+        }
+
+        // Publishes the aggregate of a tile and looks back over the preceding tiles, combining their aggregates, until it
+        // finds one that has published its inclusive prefix. Publishes the tile's own inclusive prefix and returns its
+        // exclusive prefix. Called by one thread of each tile, tiles are numbered in the order in which they start.
+        template <int TileSize, typename T, typename _BinaryFunc>
+        inline T scan_look_back(concurrency::tiled_index<TileSize> tidx, const int tile, const T& aggregate, const concurrency::array_view<unsigned int, 1>& tile_status_vw,
+            const concurrency::array_view<T, 1>& tile_aggregates_vw, const concurrency::array_view<T, 1>& tile_prefixes_vw, const _BinaryFunc& scan_op, const T& identity) restrict(amp)
+        {
+            T prefix = identity;
+            if (tile == 0)
+            {
+                tile_prefixes_vw[tile] = aggregate;
+                concurrency::global_memory_fence(tidx.barrier);
+                concurrency::atomic_exchange(&tile_status_vw[tile], scan_tile_status_prefix);
+                return prefix;
+            }
+
+            tile_aggregates_vw[tile] = aggregate;
+            concurrency::global_memory_fence(tidx.barrier);
+            concurrency::atomic_exchange(&tile_status_vw[tile], scan_tile_status_aggregate);
+
+            for (int i = tile - 1; i >= 0; --i)
+            {
+                unsigned int status;
+                do
+                {
+                    status = concurrency::atomic_fetch_add(&tile_status_vw[i], 0u);
+                }
+                while (status == scan_tile_status_invalid);
+                concurrency::global_memory_fence(tidx.barrier);
+
+                if (status == scan_tile_status_prefix)
+                {
+                    prefix = scan_op(tile_prefixes_vw[i], prefix);
+                    break;
+                }
+                prefix = scan_op(tile_aggregates_vw[i], prefix);
+            }
+
+            tile_prefixes_vw[tile] = scan_op(prefix, aggregate);
+            concurrency::global_memory_fence(tidx.barrier);
+            concurrency::atomic_exchange(&tile_status_vw[tile], scan_tile_status_prefix);
+            return prefix;
+        }
+
+        // Single pass scan using decoupled look-back, reading and writing each element once.
+        //
+        // "Single-pass Parallel Prefix Scan with Decoupled Look-back" https://research.nvidia.com/sites/default/files/pubs/2016-03_Single-pass-Parallel-Prefix/nvr-2016-002.pdf
+        //
+        // Each tile scans its elements and publishes its aggregate. It then looks back over the preceding tiles, combining
+        // their aggregates, until it finds a tile that has published its inclusive prefix. Tiles are numbered in the order
+        // in which they start, rather than by tidx.tile, so all the tiles a tile looks back at are guaranteed to be running.
+        //
+        // The elements are accessed through load(i), which returns the i-th element to scan, and store(i, value), which
+        // writes its result, so the same kernel scans views in either direction, segments and rows.
+        template <int TileSize, scan_mode _Mode, typename T, typename _BinaryFunc, typename _Load, typename _Store>
+        inline void scan_single_pass_impl(const concurrency::accelerator_view& accl_view, const int size, const _Load& load, const _Store& store, const _BinaryFunc& scan_op,
+            const T& identity)
+        {
+            if (size <= scan_single_tile_threshold)
+            {
+                _details::scan_single_tile<TileSize, _Mode>(accl_view, size, load, store, scan_op, identity);
+                return;
+            }
+
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(size).template tile<TileSize>().pad();
+            const int tile_count = compute_domain[0] / TileSize;
+
+            // The last element of tile_status is the counter used to number the tiles.
+            scratch_buffer<unsigned int> tile_status(accl_view, tile_count + 1);
+            scratch_buffer<T> tile_aggregates(accl_view, tile_count);
+            scratch_buffer<T> tile_prefixes(accl_view, tile_count);
+            concurrency::array_view<unsigned int, 1> tile_status_vw = tile_status.view();
+            concurrency::array_view<T, 1> tile_aggregates_vw = tile_aggregates.view();
+            concurrency::array_view<T, 1> tile_prefixes_vw = tile_prefixes.view();
+
+            _details::parallel_for_each(accl_view, tile_status_vw.extent, [=](concurrency::index<1> idx) restrict(amp)
+            {
+                tile_status_vw[idx] = scan_tile_status_invalid;
+            });
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                const int lidx = tidx.local[0];
+                tile_static int tile;
+                tile_static T tile_data[TileSize];
+                tile_static T tile_prefix;
+
+                if (lidx == 0)
+                {
+                    tile = int(concurrency::atomic_fetch_inc(&tile_status_vw[tile_count]));
+                }
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                const int gidx = tile * TileSize + lidx;
+                const T input = (gidx < size) ? load(gidx) : identity;
+                tile_data[lidx] = input;
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                const T val = _details::scan_tile<TileSize, _Mode>(tile_data, tidx, scan_op, identity);
+
+                // The last thread in the tile publishes the tile's results and looks back at the preceding tiles.
+                if (lidx == (TileSize - 1))
+                {
+                    const T aggregate = (_Mode == scan_mode::exclusive) ? scan_op(val, input) : val;
+                    tile_prefix = _details::scan_look_back(tidx, tile, aggregate, tile_status_vw, tile_aggregates_vw, tile_prefixes_vw, scan_op, identity);
+                }
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                if (gidx < size)
+                    store(gidx, scan_op(tile_prefix, val));
+            });
+        }
+
+        template <int TileSize, scan_mode _Mode, scan_direction _Direction = scan_direction::forward, typename _BinaryFunc, typename InputIndexableView>
+        inline void scan_single_pass(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view, const _BinaryFunc& op,
+            const typename InputIndexableView::value_type& identity)
+        {
+            typedef typename InputIndexableView::value_type T;
+
+            const int size = output_view.extent[0];
+            auto load = [=](const int idx) restrict(amp) -> T
+            {
+                return input_view[scan_index<_Direction>(idx, size)];
+            };
+            auto store = [=](const int idx, const T& value) restrict(amp)
+            {
+                output_view[scan_index<_Direction>(idx, size)] = value;
+            };
+            _details::scan_single_pass_impl<TileSize, _Mode>(accl_view, size, load, store, scan_direction_op<_Direction, _BinaryFunc>(op), identity);
+        }
+
+        // The single pass scan is used unless AMP_ALGORITHMS_SCAN_MULTI_PASS is defined. Both scan small inputs with a single tile.
+        template <int TileSize, scan_mode _Mode, scan_direction _Direction = scan_direction::forward, typename _BinaryFunc, typename InputIndexableView>
+        inline void scan(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view, const _BinaryFunc& op,
+            const typename InputIndexableView::value_type& identity)
+        {
+#if defined(AMP_ALGORITHMS_SCAN_MULTI_PASS)
+            if (output_view.extent[0] > scan_single_tile_threshold)
+            {
+                _details::scan_multi_pass<TileSize, _Mode, _Direction>(accl_view, input_view, output_view, op, identity);
+                return;
+            }
+#endif
+            _details::scan_single_pass<TileSize, _Mode, _Direction>(accl_view, input_view, output_view, op, identity);
+        }
+
+        // Segmented scan is a scan of (value, head flag) pairs using segmented_op, which restarts the scan at the head of
+        // each segment. segmented_op is associative whenever op is, so any scan implementation can be used.
+        //
+        // "Scan Primitives for GPU Computing" https://research.nvidia.com/sites/default/files/pubs/2007-08_Scan-Primitives-for/Scan%20Primitives%20for%20GPU%20Computing.pdf
+
+        template <typename T>
+        struct segmented_value
+        {
+            T value;
+            unsigned int flag;
+        };
+
+        template <typename T>
+        inline segmented_value<T> make_segmented_value(const T& value, unsigned int flag) restrict(cpu, amp)
+        {
+            segmented_value<T> result;
+            result.value = value;
+            result.flag = flag;
+            return result;
+        }
+
+        template <typename _BinaryFunc>
+        class segmented_op
+        {
+        public:
+            segmented_op(const _BinaryFunc& op) restrict(cpu, amp) : m_op(op)
+            {
+            }
+
+            template <typename T>
+            segmented_value<T> operator()(const segmented_value<T>& a, const segmented_value<T>& b) const restrict(cpu, amp)
+            {
+                return make_segmented_value((b.flag != 0) ? b.value : m_op(a.value, b.value), a.flag | b.flag);
+            }
+
+        private:
+            _BinaryFunc m_op;
+        };
+
+        // An exclusive scan of the pairs gives the result for the previous element at the head of a segment, which is
+        // replaced by the identity when the result is stored.
+        template <int TileSize, scan_mode _Mode, typename _BinaryFunc, typename InputIndexableView, typename FlagIndexableView>
+        inline void segmented_scan(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view,
+            const FlagIndexableView& flags_view, const _BinaryFunc& op, const typename InputIndexableView::value_type& identity)
+        {
+            typedef typename InputIndexableView::value_type T;
+
+            auto load = [=](const int idx) restrict(amp) -> segmented_value<T>
+            {
+                return make_segmented_value(input_view[idx], (flags_view[idx] != 0) ? 1u : 0u);
+            };
+            auto store = [=](const int idx, const segmented_value<T>& value) restrict(amp)
+            {
+                output_view[idx] = ((_Mode == scan_mode::exclusive) && (flags_view[idx] != 0)) ? identity : value.value;
+            };
+            _details::scan_single_pass_impl<TileSize, _Mode>(accl_view, output_view.extent[0], load, store, segmented_op<_BinaryFunc>(op), make_segmented_value(identity, 0u));
+        }
+
+        // Scans each row of a rank 2 view as a segment, so short rows are packed into tiles and long rows span several
+        // tiles, and all the rows are scanned by a single kernel.
+        template <int TileSize, scan_mode _Mode, typename _BinaryFunc, typename InputIndexableView>
+        inline void multi_scan(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, InputIndexableView& output_view,
+            const _BinaryFunc& op, const typename InputIndexableView::value_type& identity)
+        {
+            static_assert(InputIndexableView::rank == 2, "Multi scan requires a view of Rank 2.");
+            typedef typename InputIndexableView::value_type T;
+
+            const int row_size = output_view.extent[1];
+            auto load = [=](const int idx) restrict(amp) -> segmented_value<T>
+            {
+                const int col = idx % row_size;
+                return make_segmented_value(input_view(idx / row_size, col), (col == 0) ? 1u : 0u);
+            };
+            auto store = [=](const int idx, const segmented_value<T>& value) restrict(amp)
+            {
+                const int col = idx % row_size;
+                output_view(idx / row_size, col) = ((_Mode == scan_mode::exclusive) && (col == 0)) ? identity : value.value;
+            };
+            _details::scan_single_pass_impl<TileSize, _Mode>(accl_view, output_view.extent.size(), load, store, segmented_op<_BinaryFunc>(op), make_segmented_value(identity, 0u));
+        }
+
+        // Sets the head flag of each segment starting at one of the offsets, offsets outside flags_view are ignored.
+        template <typename OffsetIndexableView>
+        inline void segment_flags_from_offsets(const concurrency::accelerator_view& accl_view, const OffsetIndexableView& offsets_view, concurrency::array_view<unsigned int, 1>& flags_view)
+        {
+            _details::parallel_for_each(accl_view, flags_view.extent, [=](concurrency::index<1> idx) restrict(amp)
+            {
+                flags_view[idx] = 0;
+            });
+            _details::parallel_for_each(accl_view, offsets_view.extent, [=](concurrency::index<1> idx) restrict(amp)
+            {
+                const int offset = offsets_view[idx];
+                if ((offset >= 0) && (offset < flags_view.extent[0]))
+                    flags_view[offset] = 1;
+            });
+        }
+
+        //----------------------------------------------------------------------------
+        // merge sort implementation
+        //----------------------------------------------------------------------------
+        //
+        // "Merge Path - A Visually Intuitive Approach to Parallel Merging" http://arxiv.org/abs/1406.2628
+        // "Modern GPU, Merge" http://nvlabs.github.io/moderngpu/merge.html
+
+        // Each tile of a merge writes merge_tile_size * merge_items_per_thread elements.
+        static const int merge_tile_size = 128;
+        static const int merge_items_per_thread = 4;
+
+        // The number of elements of a that come before diag elements of the merge of a[a_first, a_first + a_count) and
+        // b[b_first, b_first + b_count). Elements of a come before equal elements of b, so merges are stable.
+        template <typename InputA, typename InputB, typename _Compare>
+        inline int merge_path(const InputA& a, const int a_first, const int a_count, const InputB& b, const int b_first, const int b_count, const int diag, const _Compare& comp) restrict(cpu, amp)
+        {
+            int lo = (diag > b_count) ? (diag - b_count) : 0;
+            int hi = (diag < a_count) ? diag : a_count;
+            while (lo < hi)
+            {
+                const int mid = (lo + hi) / 2;
+                if (comp(b[b_first + diag - 1 - mid], a[a_first + mid]))
+                {
+                    hi = mid;
+                }
+                else
+                {
+                    lo = mid + 1;
+                }
+            }
+            return lo;
+        }
+
+        // Merges count elements starting from a_idx in a and b_idx in b into items, a thread merges a few elements this way
+        // after finding where to start with merge_path.
+        template <int ItemsPerThread, typename T, typename InputA, typename InputB, typename _Compare>
+        inline void merge_serial(const InputA& a, int a_idx, const int a_end, const InputB& b, int b_idx, const int b_end, T* const items, const int count, const _Compare& comp) restrict(cpu, amp)
+        {
+            for (int i = 0; i < ItemsPerThread; ++i)
+            {
+                if (i < count)
+                {
+                    const bool take_a = (b_idx >= b_end) || ((a_idx < a_end) && !comp(b[b_idx], a[a_idx]));
+                    items[i] = take_a ? a[a_idx++] : b[b_idx++];
+                }
+            }
+        }
+
+        // Sorts each tile of TileSize * ItemsPerThread elements. Each thread sorts its elements with an insertion sort,
+        // then the sorted runs in tile memory are merged pairwise until the whole tile is sorted.
+        template <int TileSize, int ItemsPerThread, typename T, typename _Compare>
+        void merge_sort_tiles(const concurrency::accelerator_view& accl_view, const concurrency::array_view<T>& input_view, const _Compare& comp)
+        {
+            static const int tile_span = TileSize * ItemsPerThread;
+            const int size = input_view.extent[0];
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(((size + tile_span - 1) / tile_span) * TileSize).template tile<TileSize>();
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                tile_static T tile_data[tile_span];
+                const int idx = tidx.local[0];
+                const int tile_start = tidx.tile[0] * tile_span;
+                const int tile_count = ((size - tile_start) < tile_span) ? (size - tile_start) : tile_span;
+                const int first = idx * ItemsPerThread;
+
+                T items[ItemsPerThread];
+                int count = 0;
+                for (int i = 0; i < ItemsPerThread; ++i)
+                {
+                    if ((first + i) < tile_count)
+                    {
+                        items[i] = input_view[tile_start + first + i];
+                        ++count;
+                    }
+                }
+
+                for (int i = 1; i < count; ++i)
+                {
+                    const T item = items[i];
+                    int j = i;
+                    for (; (j > 0) && comp(item, items[j - 1]); --j)
+                    {
+                        items[j] = items[j - 1];
+                    }
+                    items[j] = item;
+                }
+
+                for (int run = ItemsPerThread; run < tile_span; run *= 2)
+                {
+                    for (int i = 0; i < count; ++i)
+                    {
+                        tile_data[first + i] = items[i];
+                    }
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+
+                    const int a_first = (first / (2 * run)) * (2 * run);
+                    const int a_end = ((a_first + run) < tile_count) ? (a_first + run) : tile_count;
+                    const int b_end = ((a_end + run) < tile_count) ? (a_end + run) : tile_count;
+                    const int diag = first - a_first;
+                    if (first < tile_count)
+                    {
+                        const int a_idx = a_first + _details::merge_path(tile_data, a_first, a_end - a_first, tile_data, a_end, b_end - a_end, diag, comp);
+                        const int b_idx = a_end + diag - (a_idx - a_first);
+                        _details::merge_serial<ItemsPerThread>(tile_data, a_idx, a_end, tile_data, b_idx, b_end, items, count, comp);
+                    }
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+                }
+
+                for (int i = 0; i < count; ++i)
+                {
+                    input_view[tile_start + first + i] = items[i];
+                }
+            });
+        }
+
+        // Loads the part of the merge of a[a_first, a_first + a_count) and b[b_first, b_first + b_count) that a tile
+        // merges into tile_data, the elements from a followed by those from b. A tile merges TileSize * ItemsPerThread
+        // elements starting with the diag_start'th, the merge path at the start and end of these gives the parts of a
+        // and b to load. Returns the number of elements loaded, the first elements loaded from a and b and the number
+        // from a are returned in tile_a_first, tile_b_first and tile_a_count.
+        template <int TileSize, int ItemsPerThread, typename InputA, typename InputB, typename T, typename _Compare>
+        int merge_tile_load(concurrency::tiled_index<TileSize> tidx, const InputA& a, const int a_first, const int a_count, const InputB& b, const int b_first, const int b_count,
+            const int diag_start, T* const tile_data, int& tile_a_first, int& tile_a_count, int& tile_b_first, const _Compare& comp) restrict(amp)
+        {
+            static const int tile_span = TileSize * ItemsPerThread;
+            tile_static int tile_splits[2];
+
+            const int idx = tidx.local[0];
+            const int diag_end = ((diag_start + tile_span) < (a_count + b_count)) ? (diag_start + tile_span) : (a_count + b_count);
+            if (idx < 2)
+            {
+                tile_splits[idx] = _details::merge_path(a, a_first, a_count, b, b_first, b_count, (idx == 0) ? diag_start : diag_end, comp);
+            }
+            tidx.barrier.wait_with_tile_static_memory_fence();
+
+            tile_a_first = a_first + tile_splits[0];
+            tile_a_count = tile_splits[1] - tile_splits[0];
+            tile_b_first = b_first + diag_start - tile_splits[0];
+            const int tile_count = diag_end - diag_start;
+            for (int i = idx; i < tile_count; i += TileSize)
+            {
+                tile_data[i] = (i < tile_a_count) ? a[tile_a_first + i] : b[tile_b_first + i - tile_a_count];
+            }
+            tidx.barrier.wait_with_tile_static_memory_fence();
+            return tile_count;
+        }
+
+        // Writes TileSize * ItemsPerThread consecutive elements of the merge of a[a_first, a_first + a_count) and
+        // b[b_first, b_first + b_count), starting with the diag_start'th, to output_view from output_start. Each thread
+        // finds its own starting point in the tile's elements and merges ItemsPerThread of them.
+        template <int TileSize, int ItemsPerThread, typename InputA, typename InputB, typename T, typename _Compare>
+        void merge_tile(concurrency::tiled_index<TileSize> tidx, const InputA& a, const int a_first, const int a_count, const InputB& b, const int b_first, const int b_count,
+            const int diag_start, const concurrency::array_view<T>& output_view, const int output_start, const _Compare& comp) restrict(amp)
+        {
+            tile_static T tile_data[TileSize * ItemsPerThread];
+            int tile_a_first;
+            int tile_a_count;
+            int tile_b_first;
+            const int tile_count = merge_tile_load<TileSize, ItemsPerThread>(tidx, a, a_first, a_count, b, b_first, b_count, diag_start, tile_data, tile_a_first, tile_a_count, tile_b_first, comp);
+
+            const int idx = tidx.local[0];
+            const int first = idx * ItemsPerThread;
+            if (first < tile_count)
+            {
+                T items[ItemsPerThread];
+                const int count = ((tile_count - first) < ItemsPerThread) ? (tile_count - first) : ItemsPerThread;
+                const int a_idx = _details::merge_path(tile_data, 0, tile_a_count, tile_data, tile_a_count, tile_count - tile_a_count, first, comp);
+                _details::merge_serial<ItemsPerThread>(tile_data, a_idx, tile_a_count, tile_data, tile_a_count + first - a_idx, tile_count, items, count, comp);
+                for (int i = 0; i < count; ++i)
+                {
+                    output_view[output_start + first + i] = items[i];
+                }
+            }
+        }
+
+        // Merges the pairs of sorted runs of run_size elements in input_view into output_view.
+        template <int TileSize, int ItemsPerThread, typename T, typename _Compare>
+        void merge_sort_pass(const concurrency::accelerator_view& accl_view, const concurrency::array_view<T>& input_view, const concurrency::array_view<T>& output_view, const int run_size, const _Compare& comp)
+        {
+            static const int tile_span = TileSize * ItemsPerThread;
+            const int size = input_view.extent[0];
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(((size + tile_span - 1) / tile_span) * TileSize).template tile<TileSize>();
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                // The tile is inside a single pair of runs because run_size is a multiple of tile_span.
+                const int output_start = tidx.tile[0] * tile_span;
+                const int a_first = (output_start / (2 * run_size)) * (2 * run_size);
+                const int a_end = ((a_first + run_size) < size) ? (a_first + run_size) : size;
+                const int b_end = ((a_end + run_size) < size) ? (a_end + run_size) : size;
+
+                merge_tile<TileSize, ItemsPerThread>(tidx, input_view, a_first, a_end - a_first, input_view, a_end, b_end - a_end, output_start - a_first, output_view, output_start, comp);
+            });
+        }
+
+        // Stable merge of the sorted a_view and b_view into output_view, equal elements of a_view come first.
+        template <int TileSize, int ItemsPerThread, typename InputIndexableView1, typename InputIndexableView2, typename T, typename _Compare>
+        void merge(const concurrency::accelerator_view& accl_view, const InputIndexableView1& a_view, const InputIndexableView2& b_view, const concurrency::array_view<T>& output_view, const _Compare& comp)
+        {
+            static const int tile_span = TileSize * ItemsPerThread;
+            const int a_count = a_view.extent[0];
+            const int b_count = b_view.extent[0];
+            const int size = a_count + b_count;
+            if (size == 0)
+            {
+                return;
+            }
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(((size + tile_span - 1) / tile_span) * TileSize).template tile<TileSize>();
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                const int output_start = tidx.tile[0] * tile_span;
+                merge_tile<TileSize, ItemsPerThread>(tidx, a_view, 0, a_count, b_view, 0, b_count, output_start, output_view, output_start, comp);
+            });
+        }
+
+        // Stable merge sort. Sorts the tiles and then merges pairs of sorted runs, doubling the run size on each pass.
+        template <int TileSize, int ItemsPerThread, typename T, typename _Compare>
+        void merge_sort(const concurrency::accelerator_view& accl_view, concurrency::array_view<T>& input_view, const _Compare& comp)
+        {
+            static const int tile_span = TileSize * ItemsPerThread;
+            const int size = input_view.extent[0];
+            if (size <= 1)
+            {
+                return;
+            }
+
+            merge_sort_tiles<TileSize, ItemsPerThread>(accl_view, input_view, comp);
+            if (size <= tile_span)
+            {
+                return;
+            }
+
+            // Each pass merges from one buffer to the other.
+            scratch_buffer<T> tmp(accl_view, size);
+            concurrency::array_view<T> src_view = input_view;
+            concurrency::array_view<T> dest_view = tmp.view();
+            int pass_count = 0;
+            for (int run_size = tile_span; run_size < size; run_size *= 2)
+            {
+                dest_view.discard_data();
+                merge_sort_pass<TileSize, ItemsPerThread>(accl_view, src_view, dest_view, run_size, comp);
+                std::swap(src_view, dest_view);
+                ++pass_count;
+            }
+
+            if ((pass_count % 2) != 0)
+            {
+                concurrency::copy(src_view, input_view);
+            }
+        }
+
+        //----------------------------------------------------------------------------
+        // batched binary search implementation
+        //----------------------------------------------------------------------------
+
+        enum class search_result
+        {
+            lower_bound,
+            upper_bound,
+            found
+        };
+
+        // True if element comes before the position being searched for, the first element not less than value for a
+        // lower bound and the first element greater than value for an upper bound.
+        template <search_result Result, typename T, typename U, typename _Compare>
+        inline bool search_before(const T& element, const U& value, const _Compare& comp) restrict(amp)
+        {
+            return (Result == search_result::upper_bound) ? !comp(value, element) : comp(element, value);
+        }
+
+        // Binary search of view[first, first + count) for the lower or upper bound of value.
+        template <search_result Result, typename InputIndexableView, typename T, typename _Compare>
+        inline int search_range(const InputIndexableView& view, int first, int count, const T& value, const _Compare& comp) restrict(amp)
+        {
+            while (count > 0)
+            {
+                const int half = count / 2;
+                if (_details::search_before<Result>(view[first + half], value, comp))
+                {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else
+                {
+                    count = half;
+                }
+            }
+            return first;
+        }
+
+        // Index of the i'th of TileSize evenly spaced elements of a sorted view of size elements. Written so that
+        // i * size does not overflow.
+        template <int TileSize>
+        inline int search_splitter(const int i, const int size) restrict(cpu, amp)
+        {
+            return (size / TileSize) * i + ((size % TileSize) * i) / TileSize;
+        }
+
+        // Searches the sorted haystack_view for every element of values_view and writes its lower bound, upper bound
+        // or whether it was found to output_view. Each tile loads TileSize evenly spaced elements of the haystack into
+        // tile memory, the top levels of the search tree shared by all the tile's searches. Each thread then searches
+        // these for its value and finishes in the part of the haystack between two of them, which only reads
+        // about log2(haystack size / TileSize) elements of global memory.
+        template <int TileSize, search_result Result, typename InputIndexableView1, typename InputIndexableView2, typename OutputIndexableView, typename _Compare>
+        void batched_search(const concurrency::accelerator_view& accl_view, const InputIndexableView1& haystack_view, const InputIndexableView2& values_view, const OutputIndexableView& output_view, const _Compare& comp)
+        {
+            typedef typename std::remove_const<typename InputIndexableView1::value_type>::type T;
+            const int haystack_size = haystack_view.extent[0];
+            const int value_count = values_view.extent[0];
+            if ((haystack_size == 0) || (value_count == 0))
+            {
+                return;
+            }
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(value_count).template tile<TileSize>().pad();
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                tile_static T tile_splitters[TileSize];
+                const int idx = tidx.local[0];
+                const int gidx = tidx.global[0];
+                tile_splitters[idx] = haystack_view[_details::search_splitter<TileSize>(idx, haystack_size)];
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                if (gidx >= value_count)
+                {
+                    return;
+                }
+                const auto value = values_view[gidx];
+
+                // Find how many splitters come before the position, which lies after the last of them and at or before
+                // the next.
+                const int splitter = _details::search_range<Result>(tile_splitters, 0, TileSize, value, comp);
+                const int lo = (splitter == 0) ? 0 : (_details::search_splitter<TileSize>(splitter - 1, haystack_size) + 1);
+                const int hi = (splitter == TileSize) ? haystack_size : _details::search_splitter<TileSize>(splitter, haystack_size);
+                const int first = _details::search_range<Result>(haystack_view, lo, hi - lo, value, comp);
+
+                if (Result == search_result::found)
+                {
+                    output_view[gidx] = ((first < haystack_size) && !comp(value, haystack_view[first])) ? 1 : 0;
+                }
+                else
+                {
+                    output_view[gidx] = first;
+                }
+            });
+        }
+
+        //----------------------------------------------------------------------------
+        // set operations implementation
+        //----------------------------------------------------------------------------
+
+        // The inputs are partitioned into tiles along the merge path, as for a merge. A first pass counts the elements
+        // each tile keeps and a scan of the counts gives each tile's offset in the output, which a second pass writes.
+        //
+        // An element of a value with m copies in a and n in b is kept by the STL rules for sorted ranges with equal
+        // elements. Its rank, the number of equal elements before it in its own input, and the number of equal elements
+        // in the other input decide:
+        //
+        //   set_union                  all of a, and the elements of b with rank >= m
+        //   set_intersection           the elements of a with rank < n
+        //   set_difference             the elements of a with rank >= n
+        //   set_symmetric_difference   the elements of a with rank >= n and of b with rank >= m
+        //
+        // The merge position of an element already gives the number of elements of the other input before it, because
+        // a's elements come before equal elements of b, so only the ends of the runs of equal elements are needed. These
+        // are found in the tile's elements, which are already in tile memory, and the global inputs are only searched
+        // when a run crosses the edge of the tile. Distinct elements need one or two comparisons, as for a merge.
+
+        enum class set_operation
+        {
+            set_union,
+            set_intersection,
+            set_difference,
+            set_symmetric_difference
+        };
+
+        // The first element equal to value in view, given that the elements before view[view_first + idx - seg_first]
+        // are not greater than it. tile_data from seg_first holds the view's elements from view_first.
+        template <typename InputIndexableView, typename T, typename _Compare>
+        inline int set_run_start(const T* const tile_data, const int seg_first, const int idx, const InputIndexableView& view, const int view_first, const T& value, const _Compare& comp) restrict(amp)
+        {
+            int pos = idx;
+            if ((pos > seg_first) && !comp(tile_data[pos - 1], value))
+            {
+                pos = _details::search_range<search_result::lower_bound>(tile_data, seg_first, pos - seg_first, value, comp);
+            }
+            const int start = view_first + pos - seg_first;
+            if ((pos == seg_first) && (start > 0) && !comp(view[start - 1], value))
+            {
+                return _details::search_range<search_result::lower_bound>(view, 0, start, value, comp);
+            }
+            return start;
+        }
+
+        // One past the last element equal to value in view, given that the elements from view[view_first + idx - seg_first]
+        // are not less than it. tile_data[seg_first, seg_end) holds the view's elements from view_first.
+        template <typename InputIndexableView, typename T, typename _Compare>
+        inline int set_run_end(const T* const tile_data, const int seg_first, const int seg_end, const int idx, const InputIndexableView& view, const int view_first, const int view_count, const T& value, const _Compare& comp) restrict(amp)
+        {
+            int pos = idx;
+            if ((pos < seg_end) && !comp(value, tile_data[pos]))
+            {
+                pos = _details::search_range<search_result::upper_bound>(tile_data, pos, seg_end - pos, value, comp);
+            }
+            const int end = view_first + pos - seg_first;
+            if ((pos == seg_end) && (end < view_count) && !comp(value, view[end]))
+            {
+                return _details::search_range<search_result::upper_bound>(view, end, view_count - end, value, comp);
+            }
+            return end;
+        }
+
+        // Merges the tile's part of a and b, as merge_tile does, and leaves the elements each thread keeps in items.
+        // Returns the number of elements the thread keeps.
+        template <int TileSize, int ItemsPerThread, set_operation Op, typename InputA, typename InputB, typename T, typename _Compare>
+        int set_operation_tile(concurrency::tiled_index<TileSize> tidx, const InputA& a, const int a_count, const InputB& b, const int b_count, T* const items, const _Compare& comp) restrict(amp)
+        {
+            tile_static T tile_data[TileSize * ItemsPerThread];
+            const int diag_start = tidx.tile[0] * TileSize * ItemsPerThread;
+            int tile_a_first;
+            int tile_a_count;
+            int tile_b_first;
+            const int tile_count = merge_tile_load<TileSize, ItemsPerThread>(tidx, a, 0, a_count, b, 0, b_count, diag_start, tile_data, tile_a_first, tile_a_count, tile_b_first, comp);
+
+            // Elements [0, tile_a_count) of tile_data are a's from tile_a_first and the rest are b's from tile_b_first.
+            const int first = tidx.local[0] * ItemsPerThread;
+            int kept = 0;
+            if (first < tile_count)
+            {
+                int a_idx = _details::merge_path(tile_data, 0, tile_a_count, tile_data, tile_a_count, tile_count - tile_a_count, first, comp);
+                int b_idx = tile_a_count + first - a_idx;
+                for (int i = 0; i < ItemsPerThread; ++i)
+                {
+                    if ((first + i) < tile_count)
+                    {
+                        if ((b_idx >= tile_count) || ((a_idx < tile_a_count) && !comp(tile_data[b_idx], tile_data[a_idx])))
+                        {
+                            // An element of a is kept depending on its rank in a and the number of equal elements of b.
+                            const T value = tile_data[a_idx];
+                            bool keep = true;
+                            if (Op != set_operation::set_union)
+                            {
+                                const int rank = tile_a_first + a_idx - set_run_start(tile_data, 0, a_idx, a, tile_a_first, value, comp);
+                                const int b_pos = tile_b_first + b_idx - tile_a_count;
+                                const int n = set_run_end(tile_data, tile_a_count, tile_count, b_idx, b, tile_b_first, b_count, value, comp) - b_pos;
+                                keep = (Op == set_operation::set_intersection) ? (rank < n) : (rank >= n);
+                            }
+                            if (keep)
+                            {
+                                items[kept++] = value;
+                            }
+                            ++a_idx;
+                        }
+                        else
+                        {
+                            // An element of b is kept depending on its rank in b and the number of equal elements of a.
+                            const T value = tile_data[b_idx];
+                            if ((Op == set_operation::set_union) || (Op == set_operation::set_symmetric_difference))
+                            {
+                                const int b_pos = tile_b_first + b_idx - tile_a_count;
+                                const int rank = b_pos - set_run_start(tile_data, tile_a_count, b_idx, b, tile_b_first, value, comp);
+                                const int m = tile_a_first + a_idx - set_run_start(tile_data, 0, a_idx, a, tile_a_first, value, comp);
+                                if (rank >= m)
+                                {
+                                    items[kept++] = value;
+                                }
+                            }
+                            ++b_idx;
+                        }
+                    }
+                }
+            }
+            return kept;
+        }
+
+        template <int TileSize, int ItemsPerThread>
+        inline int set_operation_tile_count(const int a_count, const int b_count)
+        {
+            static const int tile_span = TileSize * ItemsPerThread;
+            return (a_count + b_count + tile_span - 1) / tile_span;
+        }
+
+        // First pass of a set operation. Writes the inclusive scan of the number of elements each tile keeps to
+        // tile_offsets_view, which has set_operation_tile_count elements, and returns the size of the output.
+        template <int TileSize, int ItemsPerThread, set_operation Op, typename InputIndexableView1, typename InputIndexableView2, typename _Compare>
+        int set_operation_count(const concurrency::accelerator_view& accl_view, const InputIndexableView1& a_view, const InputIndexableView2& b_view,
+            const concurrency::array_view<unsigned int>& tile_offsets_view, const _Compare& comp)
+        {
+            typedef typename std::remove_const<typename InputIndexableView1::value_type>::type T;
+            const int a_count = a_view.extent[0];
+            const int b_count = b_view.extent[0];
+            const int tile_count = set_operation_tile_count<TileSize, ItemsPerThread>(a_count, b_count);
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(tile_count * TileSize).template tile<TileSize>();
+
+            tile_offsets_view.discard_data();
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                tile_static unsigned int tile_kept;
+                T items[ItemsPerThread];
+                if (tidx.local[0] == 0)
+                {
+                    tile_kept = 0;
+                }
+                // set_operation_tile waits on the tile barrier, so tile_kept is zeroed before any thread adds to it.
+                const int kept = set_operation_tile<TileSize, ItemsPerThread, Op>(tidx, a_view, a_count, b_view, b_count, items, comp);
+                concurrency::atomic_fetch_add(&tile_kept, static_cast<unsigned int>(kept));
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                if (tidx.local[0] == 0)
+                {
+                    tile_offsets_view[tidx.tile[0]] = tile_kept;
+                }
+            });
+
+            concurrency::array_view<unsigned int> offsets_view = tile_offsets_view;
+            _details::scan<_details::scan_default_tile_size, scan_mode::inclusive>(accl_view, offsets_view, offsets_view, amp_algorithms::plus<unsigned int>(), 0u);
+
+            unsigned int output_count;
+            concurrency::copy(offsets_view.section(tile_count - 1, 1), stdext::make_checked_array_iterator(&output_count, 1));
+            return int(output_count);
+        }
+
+        // Second pass of a set operation, writes the kept elements of each tile to output_view from the tile's offset.
+        template <int TileSize, int ItemsPerThread, set_operation Op, typename InputIndexableView1, typename InputIndexableView2, typename T, typename _Compare>
+        void set_operation_write(const concurrency::accelerator_view& accl_view, const InputIndexableView1& a_view, const InputIndexableView2& b_view,
+            const concurrency::array_view<unsigned int>& tile_offsets_view, const concurrency::array_view<T>& output_view, const _Compare& comp)
+        {
+            const int a_count = a_view.extent[0];
+            const int b_count = b_view.extent[0];
+            const int tile_count = set_operation_tile_count<TileSize, ItemsPerThread>(a_count, b_count);
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(tile_count * TileSize).template tile<TileSize>();
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                tile_static int tile_offsets[TileSize];
+                T items[ItemsPerThread];
+                const int idx = tidx.local[0];
+                const int tile = tidx.tile[0];
+                const int kept = set_operation_tile<TileSize, ItemsPerThread, Op>(tidx, a_view, a_count, b_view, b_count, items, comp);
+
+                tile_offsets[idx] = kept;
+                const int offset = _details::scan_tile_tree<TileSize, scan_mode::exclusive>(tile_offsets, tidx, amp_algorithms::plus<int>(), 0);
+                const int output_start = ((tile == 0) ? 0 : int(tile_offsets_view[tile - 1])) + offset;
+                for (int i = 0; i < ItemsPerThread; ++i)
+                {
+                    if (i < kept)
+                    {
+                        output_view[output_start + i] = items[i];
+                    }
+                }
+            });
+        }
+
+        //----------------------------------------------------------------------------
+        // stream compaction implementation
+        //----------------------------------------------------------------------------
+
+        // Stable stream compaction in a single pass. Each tile loads its elements and evaluates keep(i, value) for them,
+        // scans the keep flags in tile memory and gets the number of elements kept by the preceding tiles with the
+        // decoupled look-back of the single pass scan, then writes its kept elements to output_view. Returns the number
+        // of elements kept.
+        //
+        // If WriteRejected the other elements are written from the back of output_view towards the front, so the
+        // output is partitioned with the rejected elements in reverse order. Otherwise a tile loads its elements before
+        // publishing its count, and only writes once the tiles before it have published theirs. Kept elements never
+        // move towards the end, so output_view may be input_view and keep may also read the element before i.
+        template <int TileSize, bool WriteRejected, typename InputIndexableView, typename OutputIndexableView, typename _Keep>
+        int compact(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, const OutputIndexableView& output_view, const _Keep& keep)
+        {
+            typedef typename std::remove_const<typename InputIndexableView::value_type>::type T;
+
+            const int size = input_view.extent[0];
+            if (size == 0)
+            {
+                return 0;
+            }
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(size).template tile<TileSize>().pad();
+            const int tile_count = compute_domain[0] / TileSize;
+
+            // The last element of tile_status is the counter used to number the tiles. The inclusive prefix of the last
+            // tile is the number of elements kept.
+            scratch_buffer<unsigned int> tile_status(accl_view, tile_count + 1);
+            scratch_buffer<unsigned int> tile_aggregates(accl_view, tile_count);
+            scratch_buffer<unsigned int> tile_prefixes(accl_view, tile_count);
+            concurrency::array_view<unsigned int, 1> tile_status_vw = tile_status.view();
+            concurrency::array_view<unsigned int, 1> tile_aggregates_vw = tile_aggregates.view();
+            concurrency::array_view<unsigned int, 1> tile_prefixes_vw = tile_prefixes.view();
+
+            _details::parallel_for_each(accl_view, tile_status_vw.extent, [=](concurrency::index<1> idx) restrict(amp)
+            {
+                tile_status_vw[idx] = scan_tile_status_invalid;
+            });
+
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                const int lidx = tidx.local[0];
+                tile_static int tile;
+                tile_static unsigned int tile_flags[TileSize];
+                tile_static unsigned int tile_prefix;
+
+                if (lidx == 0)
+                {
+                    tile = int(concurrency::atomic_fetch_inc(&tile_status_vw[tile_count]));
+                }
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                const int gidx = tile * TileSize + lidx;
+                const bool is_valid = (gidx < size);
+                const T value = is_valid ? input_view[gidx] : T();
+                const unsigned int flag = (is_valid && keep(gidx, value)) ? 1 : 0;
+                tile_flags[lidx] = flag;
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                const unsigned int offset = _details::scan_tile_tree<TileSize, scan_mode::exclusive>(tile_flags, tidx, amp_algorithms::plus<unsigned int>(), 0u);
+
+                if (lidx == (TileSize - 1))
+                {
+                    tile_prefix = _details::scan_look_back(tidx, tile, offset + flag, tile_status_vw, tile_aggregates_vw, tile_prefixes_vw, amp_algorithms::plus<unsigned int>(), 0u);
+                }
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                if (flag != 0)
+                {
+                    output_view[tile_prefix + offset] = value;
+                }
+                else if (WriteRejected && is_valid)
+                {
+                    output_view[size - 1 - (gidx - int(tile_prefix + offset))] = value;
+                }
+            });
+
+            unsigned int kept_count;
+            concurrency::copy(tile_prefixes_vw.section(tile_count - 1, 1), stdext::make_checked_array_iterator(&kept_count, 1));
+            return int(kept_count);
+        }
+
+        template <int TileSize, typename InputIndexableView, typename OutputIndexableView, typename _Keep>
+        int compact(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, const OutputIndexableView& output_view, const _Keep& keep)
+        {
+            return _details::compact<TileSize, false>(accl_view, input_view, output_view, keep);
+        }
+
+        //----------------------------------------------------------------------------
+        // partition implementation
+        //----------------------------------------------------------------------------
+
+        // Writes the elements of input_view for which p is true to the front of output_view and the others to its back,
+        // in no particular order, and returns the number of the former. Each tile counts its elements of each kind in
+        // tile memory and reserves space for them at both ends of the output with a single atomic per kind, so unlike
+        // compact the tiles do not wait on each other. output_view must not be input_view.
+        template <int TileSize, typename InputIndexableView, typename OutputIndexableView, typename _Predicate>
+        int partition(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, const OutputIndexableView& output_view, const _Predicate& p)
+        {
+            typedef typename std::remove_const<typename InputIndexableView::value_type>::type T;
+
+            const int size = input_view.extent[0];
+            if (size == 0)
+            {
+                return 0;
+            }
+            // The number of elements placed at the front and at the back of the output.
+            scratch_buffer<unsigned int> partition_counts(accl_view, 2);
+            concurrency::array_view<unsigned int, 1> partition_counts_vw = partition_counts.view();
+            _details::parallel_for_each(accl_view, partition_counts_vw.extent, [=](concurrency::index<1> idx) restrict(amp)
+            {
+                partition_counts_vw[idx] = 0;
+            });
+
+            const concurrency::tiled_extent<TileSize> compute_domain = concurrency::extent<1>(size).template tile<TileSize>().pad();
+            _details::parallel_for_each(accl_view, compute_domain, [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                tile_static unsigned int tile_counts[2];
+                tile_static unsigned int tile_starts[2];
+                const int idx = tidx.local[0];
+                const int gidx = tidx.global[0];
+                if (idx < 2)
+                {
+                    tile_counts[idx] = 0;
+                }
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                const bool is_valid = (gidx < size);
+                const T value = is_valid ? input_view[gidx] : T();
+                int side = 0;
+                unsigned int rank = 0;
+                if (is_valid)
+                {
+                    side = p(value) ? 0 : 1;
+                    rank = concurrency::atomic_fetch_inc(&tile_counts[side]);
+                }
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                if (idx < 2)
+                {
+                    tile_starts[idx] = concurrency::atomic_fetch_add(&partition_counts_vw[idx], tile_counts[idx]);
+                }
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                if (is_valid)
+                {
+                    const int position = int(tile_starts[side] + rank);
+                    output_view[(side == 0) ? position : (size - 1 - position)] = value;
+                }
+            });
+
+            unsigned int front_count;
+            concurrency::copy(partition_counts_vw.section(0, 1), stdext::make_checked_array_iterator(&front_count, 1));
+            return int(front_count);
+        }
+
+        //----------------------------------------------------------------------------
+        // find implementation
+        //----------------------------------------------------------------------------
+
+        // A search launches at most find_max_tiles tiles, which take chunks of find_tile_size elements.
+        static const int find_tile_size = 256;
+        static const int find_max_tiles = 256;
+
+        // Returns the first index in [0, size) for which p(index) is true, or size if there is none.
+        //
+        // The tiles are persistent and take the next chunk of the input from a shared counter, so the chunks are taken in
+        // order. Each tile reduces the matches in a chunk to their minimum in tile memory and a single thread records it
+        // in the shared best index with one atomic. A tile stops once the next chunk starts beyond the best index, as
+        // every match before it is in a chunk that has already been taken. A match near the front of the input ends the
+        // search after the first chunk of each tile.
+        template <int TileSize, int MaxTiles, typename _IndexPredicate>
+        int find_first(const concurrency::accelerator_view& accl_view, const int size, const _IndexPredicate& p)
+        {
+            if (size == 0)
+            {
+                return 0;
+            }
+            const int chunk_count = (size + TileSize - 1) / TileSize;
+            const int tile_count = (chunk_count < MaxTiles) ? chunk_count : MaxTiles;
+
+            // The best index found so far and the counter used to hand out the chunks.
+            scratch_buffer<int> search_state(accl_view, 2);
+            concurrency::array_view<int, 1> search_state_vw = search_state.view();
+            _details::parallel_for_each(accl_view, search_state_vw.extent, [=](concurrency::index<1> idx) restrict(amp)
+            {
+                search_state_vw[idx] = (idx[0] == 0) ? size : 0;
+            });
+
+            _details::parallel_for_each(accl_view, concurrency::extent<1>(tile_count * TileSize).template tile<TileSize>(), [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                tile_static int chunk_start;
+                tile_static int tile_match;
+                const int idx = tidx.local[0];
+
+                while (true)
+                {
+                    if (idx == 0)
+                    {
+                        // The best index is read atomically, as other tiles may be updating it. It may be stale,
+                        // which only delays the exit.
+                        chunk_start = concurrency::atomic_fetch_inc(&search_state_vw[1]) * TileSize;
+                        chunk_start = (chunk_start < concurrency::atomic_fetch_add(&search_state_vw[0], 0)) ? chunk_start : -1;
+                        tile_match = size;
+                    }
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+
+                    if (chunk_start < 0)
+                    {
+                        break;
+                    }
+                    const int gidx = chunk_start + idx;
+                    if ((gidx < size) && p(gidx))
+                    {
+                        concurrency::atomic_fetch_min(&tile_match, gidx);
+                    }
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+
+                    if ((idx == 0) && (tile_match < size))
+                    {
+                        concurrency::atomic_fetch_min(&search_state_vw[0], tile_match);
+                    }
+                }
+            });
+
+            int match;
+            concurrency::copy(search_state_vw.section(0, 1), stdext::make_checked_array_iterator(&match, 1));
+            return match;
+        }
+
+        // Returns the index of the first element of input_view for which p is true, or its size if there is none.
+        template <int TileSize, int MaxTiles, typename InputIndexableView, typename _Predicate>
+        int find_if(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, const _Predicate& p)
+        {
+            return _details::find_first<TileSize, MaxTiles>(accl_view, input_view.extent[0], [=](const int idx) restrict(amp) { return p(input_view[idx]); });
+        }
+
+        // Writes found_value to result_view[0] if p is true for any element of input_view, and 1 - found_value otherwise.
+        //
+        // Each tile votes on a chunk of the input in tile memory and a single thread records a match in result_view with
+        // one atomic. Before each chunk a tile polls result_view once and stops if a match has been recorded, so all the
+        // tiles stop soon after the answer is known. The chunks may be searched in any order, so they are strided
+        // rather than handed out by a counter as for find_if.
+        template <int TileSize, int MaxTiles, typename InputIndexableView, typename _Predicate>
+        void any_of_to(const concurrency::accelerator_view& accl_view, const InputIndexableView& input_view, const _Predicate& p,
+            const concurrency::array_view<int, 1>& result_view, const int found_value)
+        {
+            const int size = input_view.extent[0];
+            const int chunk_count = (size + TileSize - 1) / TileSize;
+            const int tile_count = (chunk_count < MaxTiles) ? chunk_count : MaxTiles;
+            const int stride = tile_count * TileSize;
+
+            _details::parallel_for_each(accl_view, result_view.extent, [=](concurrency::index<1> idx) restrict(amp)
+            {
+                result_view[idx] = 1 - found_value;
+            });
+            if (size == 0)
+            {
+                return;
+            }
+
+            _details::parallel_for_each(accl_view, concurrency::extent<1>(stride).template tile<TileSize>(), [=](concurrency::tiled_index<TileSize> tidx) restrict(amp)
+            {
+                tile_static int is_found;
+                tile_static int tile_vote;
+                const int idx = tidx.local[0];
+
+                for (int chunk_start = tidx.tile[0] * TileSize; chunk_start < size; chunk_start += stride)
+                {
+                    if (idx == 0)
+                    {
+                        is_found = (concurrency::atomic_fetch_add(&result_view[0], 0) == found_value) ? 1 : 0;
+                        tile_vote = 0;
+                    }
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+
+                    if (is_found != 0)
+                    {
+                        break;
+                    }
+                    const int gidx = chunk_start + idx;
+                    if ((gidx < size) && p(input_view[gidx]))
+                    {
+                        tile_vote = 1;
+                    }
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+
+                    if ((idx == 0) && (tile_vote != 0))
+                    {
+                        concurrency::atomic_exchange(&result_view[0], found_value);
+                    }
+                }
+            });
+        }
+
+    } // namespace amp_algorithms::_details
+
+} // namespace amp_algorithms
+
+#include <xx_amp_algorithms_host_keywords_pop.h>
@@ -21,8 +21,13 @@
 
 #pragma once
 
+#if defined(_MSC_VER) && !defined(AMP_ALGORITHMS_HOST_BACKEND)
 #include <amp.h>
+#else
+#include <xx_amp_algorithms_host_impl.h>
+#endif
 #include <assert.h>
+#include <xx_amp_algorithms_host_keywords_push.h>
 
 namespace amp_stl_algorithms
 {
@@ -35,10 +40,12 @@ namespace amp_stl_algorithms
             assert(cond);
         }
 
+#if !defined(AMP_ALGORITHMS_HOST_BACKEND)
         inline void amp_assert(bool cond) restrict(amp)
         {
             // TODO: NOT IMPLEMENTED amp_assert
         }
+#endif
 
         template <typename array_type>
         inline void assert_arrays_are_same_toplevel_resource(const array_type& a1, const array_type& a2) restrict(cpu,amp)
@@ -73,11 +80,13 @@ namespace amp_stl_algorithms
                 return concurrency::array_view<value_type>(1, &stable_storage);
             }
 
+#if !defined(AMP_ALGORITHMS_HOST_BACKEND)
             // On the accelerator, use the stable storage helper.
             static concurrency::array_view<value_type> create() restrict(amp)
             {
                 return concurrency::array_view<value_type>(0, nullptr);
             }
+#endif
         };
 
         template <class value_type, int rank>
@@ -95,3 +104,5 @@ namespace amp_stl_algorithms
     } // namespace _details
 
 } // namespace amp_stl_algorithms
+
+#include <xx_amp_algorithms_host_keywords_pop.h>
@@ -25,6 +25,7 @@
 
 #include <amp_stl_algorithms.h>
 #include <amp_algorithms.h>
+#include <xx_amp_algorithms_host_keywords_push.h>
 
 namespace amp_stl_algorithms
 {
@@ -34,12 +35,22 @@ namespace amp_stl_algorithms
         concurrency::array_view<typename std::iterator_traits<ConstRandomAccessIterator>::value_type> 
             create_section(ConstRandomAccessIterator iter, typename std::iterator_traits<ConstRandomAccessIterator>::difference_type distance) 
         {
-            typedef std::iterator_traits<ConstRandomAccessIterator>::value_type value_type;
-            typedef std::iterator_traits<ConstRandomAccessIterator>::difference_type difference_type;
+            typedef typename std::iterator_traits<ConstRandomAccessIterator>::value_type value_type;
+            typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type difference_type;
             auto base_view = _details::array_view_iterator_helper<value_type>::get_base_array_view(iter);
             difference_type start = std::distance(begin(base_view), iter);
             return base_view.section(concurrency::index<1>(start), concurrency::extent<1>(distance));
         }		
+
+        // Elements are radix sorted when they are keys that radix_sort supports compared with less or greater, anything
+        // else is merge sorted. Radix sort orders -0.0 before 0.0, so float keys are only radix sorted by unstable sorts.
+        // nth_element and top_k radix select the keys that unstable sorts radix sort.
+        template <typename T, typename Compare, bool IsStable>
+        struct is_radix_sorted : std::integral_constant<bool,
+            (std::is_same<Compare, amp_algorithms::less<T>>::value || std::is_same<Compare, amp_algorithms::greater<T>>::value) &&
+            (std::is_same<T, int>::value || std::is_same<T, unsigned int>::value || (!IsStable && std::is_same<T, float>::value))>
+        {
+        };
     }
 
     // TODO: Get the tests, header and internal implementations into the same logical order.
@@ -74,12 +85,12 @@ namespace amp_stl_algorithms
         {
             const int idx = tidx.global[0];
             const int i = tidx.local[0];
-            tile_static T local_buffer[tile_size + 1];
+            tile_static typename std::remove_const<T>::type local_buffer[tile_size + 1];
 
-            local_buffer[i] = padded_read(input_view, idx - 1);
+            local_buffer[i] = amp_algorithms::padded_read(input_view, idx - 1);
             if (i == (tile_size - 1))
             {
-                local_buffer[tile_size] = padded_read(input_view, idx);
+                local_buffer[tile_size] = amp_algorithms::padded_read(input_view, idx);
             }
 
             tidx.barrier.wait_with_all_memory_fence();
@@ -90,7 +101,7 @@ namespace amp_stl_algorithms
             }
             else
             {
-                padded_write(output_view, idx, p(local_buffer[i + 1], local_buffer[i]));
+                amp_algorithms::padded_write(output_view, idx, p(local_buffer[i + 1], local_buffer[i]));
             }
         });
 
@@ -110,6 +121,57 @@ namespace amp_stl_algorithms
     // all_of, any_of, none_of
     //----------------------------------------------------------------------------
 
+    namespace _details
+    {
+        // any_of, all_of and none_of all search for an element that decides the result and stop once one is found, see
+        // amp_algorithms::_details::any_of_to. The result is found_value if there is one.
+        template<typename ConstRandomAccessIterator, typename UnaryPredicate, typename OutputIterator>
+        void any_of(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p, OutputIterator dest, const int found_value)
+        {
+            typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type diff_type;
+
+            const diff_type element_count = std::distance(first, last);
+            if (element_count <= 0)
+            {
+                amp_stl_algorithms::fill_n(dest, 1, 1 - found_value);
+                return;
+            }
+            auto section_view = _details::create_section(first, element_count);
+            auto result_view = _details::create_section(dest, 1);
+            amp_algorithms::_details::any_of_to<amp_algorithms::_details::find_tile_size, amp_algorithms::_details::find_max_tiles>(
+                amp_algorithms::_details::auto_select_target(), section_view, p, result_view, found_value);
+        }
+
+        // The future becomes ready once the result has been copied back, as for amp_algorithms::reduce_async.
+        template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+        std::future<bool> any_of_async(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p, const int found_value)
+        {
+            typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type diff_type;
+
+            auto promise = std::make_shared<std::promise<bool>>();
+            const diff_type element_count = std::distance(first, last);
+            if (element_count <= 0)
+            {
+                promise->set_value(found_value == 0);
+                return promise->get_future();
+            }
+            const concurrency::accelerator_view accl_view = amp_algorithms::_details::auto_select_target();
+            auto section_view = _details::create_section(first, element_count);
+            auto result = std::make_shared<amp_algorithms::_details::scratch_buffer<int>>(accl_view, 1);
+            amp_algorithms::_details::any_of_to<amp_algorithms::_details::find_tile_size, amp_algorithms::_details::find_max_tiles>(
+                accl_view, section_view, p, result->view(), found_value);
+
+            // The continuation keeps the result and the value it is copied to alive until the copy completes.
+            auto value = std::make_shared<int>();
+            concurrency::completion_future copied = concurrency::copy_async(result->view(), value.get());
+            copied.then([result, value, promise]()
+            {
+                promise->set_value(*value != 0);
+            });
+            return promise->get_future();
+        }
+    }; // namespace _details
+
     template<typename ConstRandomAccessIterator,  typename UnaryPredicate >
     bool all_of(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p ) 
     {
@@ -120,25 +182,24 @@ namespace amp_stl_algorithms
     }
 
     // Non-standard, OutputIterator must yield an int reference, where the result will be
-    // stored. This allows the function to eschew synchronization
+    // stored. This allows the function to eschew synchronization. The result is written
+    // whether or not an element is found.
     template<typename ConstRandomAccessIterator, typename UnaryPredicate, typename OutputIterator >
-    void any_of(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p,  OutputIterator dest)
+    void all_of(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p, OutputIterator dest)
     {
-        // TODO: Shouldn't any_of be tiled for slightly better performance?
-        auto section_view = _details::create_section(dest, 1);
-        amp_stl_algorithms::for_each_no_return(
-            first, last, 
-            [section_view, p] (const decltype(*first)& val) restrict(amp) 
-        {
-            int *accumulator = &section_view(0);
-            if (*accumulator == 0)
-            {
-                if (p(val))
-                {
-                    concurrency::atomic_exchange(accumulator, 1);
-                }
-            }
-        });
+        _details::any_of(first, last, [p] (const decltype(*first)& val) restrict(amp) { return !p(val); }, dest, 0);
+    }
+
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate, typename OutputIterator >
+    void any_of(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p, OutputIterator dest)
+    {
+        _details::any_of(first, last, p, dest, 1);
+    }
+
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate, typename OutputIterator >
+    void none_of(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p, OutputIterator dest)
+    {
+        _details::any_of(first, last, p, dest, 0);
     }
 
     // Standard, builds of top of the non-standard async version above, and adds a sync to
@@ -159,6 +220,25 @@ namespace amp_stl_algorithms
         return !amp_stl_algorithms::any_of(first, last, p);
     }
 
+    // Non-standard, the searches run without blocking the host, the futures become ready with the result.
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+    std::future<bool> all_of_async(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p)
+    {
+        return _details::any_of_async(first, last, [p] (const decltype(*first)& val) restrict(amp) { return !p(val); }, 0);
+    }
+
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+    std::future<bool> any_of_async(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p)
+    {
+        return _details::any_of_async(first, last, p, 1);
+    }
+
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+    std::future<bool> none_of_async(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p)
+    {
+        return _details::any_of_async(first, last, p, 0);
+    }
+
     //----------------------------------------------------------------------------
     // copy, copy_if, copy_n
     //----------------------------------------------------------------------------
@@ -182,6 +262,7 @@ namespace amp_stl_algorithms
         UnaryPredicate pred)
     {
         typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type diff_type;
+        typedef typename std::remove_const<typename std::iterator_traits<ConstRandomAccessIterator>::value_type>::type T;
 
         static const int tile_size = 512;
         const diff_type element_count = std::distance(first, last);
@@ -192,47 +273,9 @@ namespace amp_stl_algorithms
         auto src_view = _details::create_section(first, element_count);
         auto dest_view = _details::create_section(dest_first, element_count);
 
-        auto map_size = concurrency::extent<1>(element_count + 1).tile<tile_size>().pad().size();
-        concurrency::array<unsigned int> map(map_size);
-        concurrency::array_view<unsigned int> map_vw(map);
-        concurrency::tiled_extent<tile_size> compute_domain = concurrency::extent<1>(element_count).tile<tile_size>().pad();
-        concurrency::parallel_for_each(compute_domain,
-            [src_view, map_vw, pred, element_count](concurrency::tiled_index<tile_size> tidx) restrict(amp)
-        {
-            const int idx = tidx.global[0];
-            map_vw[idx] = (idx < element_count) ? static_cast<unsigned int>(pred(src_view[idx])) : 0;
-        });
-
-        std::vector<unsigned int> map_dbg(map_size);
-        concurrency::copy(map, begin(map_dbg));
-
-        amp_algorithms::scan_exclusive(map_vw, map_vw);
-        concurrency::copy(map, begin(map_dbg));
-
-        dest_view.discard_data();
-        concurrency::parallel_for_each(compute_domain, [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
-        {
-            const int idx = tidx.global[0];
-            const int i = tidx.local[0];
-            tile_static unsigned local_buffer[tile_size + 1];
-
-            // Use tile memory so that each value is only read once from global memory.
-            local_buffer[i] = map_vw[idx];
-            if (i == (tile_size - 1))
-            {
-                local_buffer[i + 1] = map_vw[idx + 1];
-            }
-
-            tidx.barrier.wait_with_all_memory_fence();
-
-            if ((local_buffer[i] != local_buffer[i + 1]) && (idx < element_count))
-            {
-                dest_view[map_vw[idx]] = src_view[idx];
-            }
-        });
-
-        int remaining_elements;
-        concurrency::copy(map_vw.section(element_count, 1), stdext::make_checked_array_iterator(&remaining_elements, 1));
+        // The predicate is evaluated, the kept elements counted and written in a single pass.
+        const int remaining_elements = amp_algorithms::_details::compact<tile_size>(amp_algorithms::_details::auto_select_target(), src_view, dest_view,
+            [=](const int, T value) restrict(amp) { return (pred(value) != 0); });
         return dest_first + remaining_elements;
     }
 
@@ -263,10 +306,6 @@ namespace amp_stl_algorithms
     {
         typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type diff_type;
 
-        static const int num_threads = 10 * 1024;
-        diff_type count = 0;
-        concurrency::array_view<diff_type> count_av(1, &count);
-
         diff_type element_count = std::distance(first, last);
         if (element_count <= 0)
         {
@@ -274,85 +313,171 @@ namespace amp_stl_algorithms
         }
         auto section_view = _details::create_section(first, element_count);
 
-        // TODO: Seems the global memory access isn't coherent. Can it be improved.
-        // TODO: Would a reduction be more efficient than using an atomic operation here?
-        concurrency::parallel_for_each(
-            concurrency::extent<1>(num_threads),
-            [section_view,element_count,p,count_av] (concurrency::index<1> idx) restrict (amp) 
-        {
-            int tid = idx[0];
-            diff_type local_count = 0;
-            for (diff_type i=tid; i<element_count; i += num_threads) 
-            {
-                if (p(section_view(i)))
-                {
-                    local_count++;
-                }
-            }
-            if (local_count > 0)
-            {
-                concurrency::atomic_fetch_add(&count_av(0), local_count);
-            }
-        }
-        );
-
-        count_av.synchronize();
-        return count;
+        return amp_algorithms::_details::transform_reduce<amp_algorithms::_details::reduce_tile_size, amp_algorithms::_details::reduce_max_tiles>(
+            amp_algorithms::_details::auto_select_target(), int(element_count),
+            [=](const int idx) restrict(amp) { return p(section_view[idx]) ? 1 : 0; }, amp_algorithms::plus<int>());
     }
 
     //----------------------------------------------------------------------------
     // equal, equal_range
     //----------------------------------------------------------------------------
 
+    namespace _details
+    {
+        // The index of the first pair of elements for which p is false, or element_count if there is none. This is a
+        // search that stops early, see amp_algorithms::_details::find_first, and is shared by equal and mismatch.
+        template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename BinaryPredicate>
+        typename std::iterator_traits<ConstRandomAccessIterator1>::difference_type mismatch( ConstRandomAccessIterator1 first1,
+            const typename std::iterator_traits<ConstRandomAccessIterator1>::difference_type element_count,
+            ConstRandomAccessIterator2 first2,
+            BinaryPredicate p )
+        {
+            auto section1_view = _details::create_section(first1, element_count);
+            auto section2_view = _details::create_section(first2, element_count);
+            const int size = int(element_count);
+
+            return amp_algorithms::_details::find_first<amp_algorithms::_details::find_tile_size, amp_algorithms::_details::find_max_tiles>(
+                amp_algorithms::_details::auto_select_target(), size,
+                [=](const int idx) restrict(amp) { return !p(section1_view[idx], section2_view[idx]); });
+        }
+    }; // namespace _details
+
     template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename BinaryPredicate>
     bool equal( ConstRandomAccessIterator1 first1, 
         ConstRandomAccessIterator1 last1, 
         ConstRandomAccessIterator2 first2, 
         BinaryPredicate p )
     {
-        typedef std::iterator_traits<ConstRandomAccessIterator1>::difference_type diff_type;
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::difference_type diff_type;
         diff_type element_count = std::distance(first1, last1);
         if (element_count <= 0) 
         {
             return true;
         }
-        const int tile_size = 512;
-        static const int num_threads = 10 * 1024;
-        auto section1_view = _details::create_section(first1, element_count);
-        auto section2_view = _details::create_section(first2, element_count);
-
-        diff_type unequal_count = 0;
-        concurrency::array_view<diff_type> unequal_count_av(1, &unequal_count);
-
-        // TODO: Seems the global memory access isn't coherent. Can it be improved.
-        // TODO: Would a reduction be more efficient than using an atomic operation here?
-        concurrency::parallel_for_each(
-            tiled_extent<tile_size>(concurrency::extent<1>(num_threads)).pad(),
-            [section1_view, section2_view, element_count, p, unequal_count_av] (concurrency::tiled_index<tile_size> tidx) restrict (amp) 
+        return (_details::mismatch(first1, element_count, first2, p) == element_count);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2>
+    bool equal( ConstRandomAccessIterator1 first1, ConstRandomAccessIterator1 last1, ConstRandomAccessIterator2 first2 )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+
+        return amp_stl_algorithms::equal(first1, last1, first2, [=](const T& v1, const T& v2) restrict(amp) { return (v1 == v2); });
+    }
+
+    namespace _details
+    {
+        // Searches for many values at once are batched into a single kernel, see amp_algorithms::_details::batched_search.
+        // A search for a single value is a batch of one. These are shared by equal_range, lower_bound, upper_bound and
+        // binary_search.
+
+        static const int search_tile_size = 256;
+
+        template<amp_algorithms::_details::search_result Result, typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator, typename Compare>
+        RandomAccessIterator batched_search( ConstRandomAccessIterator1 first,
+            ConstRandomAccessIterator1 last,
+            ConstRandomAccessIterator2 values_first,
+            ConstRandomAccessIterator2 values_last,
+            RandomAccessIterator result,
+            Compare comp )
         {
-            int idx = tidx.global[0];
-            diff_type i = idx;
-            for (; i < element_count; i += num_threads)
+            typedef typename std::iterator_traits<ConstRandomAccessIterator1>::difference_type diff_type;
+            typedef typename std::iterator_traits<RandomAccessIterator>::value_type result_type;
+
+            const diff_type element_count = std::distance(first, last);
+            const diff_type value_count = std::distance(values_first, values_last);
+            if (value_count <= 0)
             {
-                if (!p(section1_view[i], section2_view[i]))
-                {
-                    break;
-                }
+                return result;
             }
-            if (i < element_count)
+            // Every value has a lower and upper bound of zero and is not found in an empty range.
+            if (element_count <= 0)
             {
-                concurrency::atomic_fetch_add(&unequal_count_av(0), 1);
+                amp_stl_algorithms::fill_n(result, value_count, result_type(0));
+                return result + value_count;
             }
-        });
-        return (unequal_count_av[0] == 0);
+
+            auto haystack_view = _details::create_section(first, element_count);
+            auto values_view = _details::create_section(values_first, value_count);
+            auto result_view = _details::create_section(result, value_count);
+            result_view.discard_data();
+            amp_algorithms::_details::batched_search<search_tile_size, Result>(amp_algorithms::_details::auto_select_target(), haystack_view, values_view, result_view, comp);
+            return result + value_count;
+        }
+
+        template<amp_algorithms::_details::search_result Result, typename ConstRandomAccessIterator, typename T, typename Compare>
+        typename std::iterator_traits<ConstRandomAccessIterator>::difference_type search( ConstRandomAccessIterator first,
+            ConstRandomAccessIterator last,
+            const T& value,
+            Compare comp )
+        {
+            typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type diff_type;
+
+            const diff_type element_count = std::distance(first, last);
+            if (element_count <= 0)
+            {
+                return 0;
+            }
+
+            T search_value = value;
+            int search_result = 0;
+            concurrency::array_view<const T> value_view(1, &search_value);
+            concurrency::array_view<int> result_view(1, &search_result);
+            auto haystack_view = _details::create_section(first, element_count);
+            amp_algorithms::_details::batched_search<search_tile_size, Result>(amp_algorithms::_details::auto_select_target(), haystack_view, value_view, result_view, comp);
+            result_view.synchronize();
+            return search_result;
+        }
+    }; // namespace _details
+
+    template<typename ConstRandomAccessIterator, typename T, typename Compare>
+    std::pair<ConstRandomAccessIterator, ConstRandomAccessIterator> 
+        equal_range( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        const T& value, 
+        Compare comp )
+    {
+        const auto lower = _details::search<amp_algorithms::_details::search_result::lower_bound>(first, last, value, comp);
+        const auto upper = _details::search<amp_algorithms::_details::search_result::upper_bound>(first, last, value, comp);
+        return std::make_pair(first + lower, first + upper);
     }
 
-    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2>
-    bool equal( ConstRandomAccessIterator1 first1, ConstRandomAccessIterator1 last1, ConstRandomAccessIterator2 first2 )
+    template<typename ConstRandomAccessIterator, typename T>
+    std::pair<ConstRandomAccessIterator, ConstRandomAccessIterator> 
+        equal_range( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        const T& value )
     {
-        typedef std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::value_type value_type;
+        return amp_stl_algorithms::equal_range(first, last, value, amp_algorithms::less<value_type>());
+    }
 
-        return amp_stl_algorithms::equal(first1, last1, first2, [=](const T& v1, const T& v2) restrict(amp) { return (v1 == v2); });
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator1, typename RandomAccessIterator2, typename Compare>
+    std::pair<RandomAccessIterator1, RandomAccessIterator2> 
+        equal_range( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator1 lower_result,
+        RandomAccessIterator2 upper_result,
+        Compare comp )
+    {
+        return std::make_pair(
+            _details::batched_search<amp_algorithms::_details::search_result::lower_bound>(first, last, values_first, values_last, lower_result, comp),
+            _details::batched_search<amp_algorithms::_details::search_result::upper_bound>(first, last, values_first, values_last, upper_result, comp));
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    std::pair<RandomAccessIterator1, RandomAccessIterator2> 
+        equal_range( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator1 lower_result,
+        RandomAccessIterator2 upper_result )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        return amp_stl_algorithms::equal_range(first, last, values_first, values_last, lower_result, upper_result, amp_algorithms::less<T>());
     }
 
     //----------------------------------------------------------------------------
@@ -375,38 +500,27 @@ namespace amp_stl_algorithms
     // find, find_if, find_if_not, find_end, find_first_of, adjacent_find
     //----------------------------------------------------------------------------
 
+    // The search stops early once a match is found, see amp_algorithms::_details::find_if.
     template<typename ConstRandomAccessIterator, typename UnaryPredicate>
     ConstRandomAccessIterator find_if(ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p )
     {
-        typedef std::iterator_traits<ConstRandomAccessIterator>::difference_type difference_type;
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type difference_type;
 
         difference_type element_count = std::distance(first, last);
         if (element_count <= 0) 
         {
             return last;
         }
-
-        difference_type result_position = element_count;
-        concurrency::array_view<int> result_position_av(concurrency::extent<1>(1), &result_position);
-
         auto section_view = _details::create_section(first, element_count);
 
-        concurrency::parallel_for_each(concurrency::extent<1>(element_count), [=] (concurrency::index<1> idx) restrict(amp) {
-            int i = idx[0];
-            if (p(section_view[idx]))
-            {
-                concurrency::atomic_fetch_min(&result_position_av(0), i);
-            }
-        });
-
-        result_position_av.synchronize();
-        return first + result_position;
+        return first + amp_algorithms::_details::find_if<amp_algorithms::_details::find_tile_size, amp_algorithms::_details::find_max_tiles>(
+            amp_algorithms::_details::auto_select_target(), section_view, p);
     }
 
     template<typename ConstRandomAccessIterator, typename UnaryPredicate>
     ConstRandomAccessIterator find_if_not( ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p )
     {
-        typedef std::iterator_traits<ConstRandomAccessIterator>::value_type T;
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::value_type T;
         return amp_stl_algorithms::find_if(first, last, [p](const T& v) restrict(amp) { return !p(v); });
     }
 
@@ -424,6 +538,7 @@ namespace amp_stl_algorithms
         ConstRandomAccessIterator adjacent_find (ConstRandomAccessIterator first, 
             const typename std::iterator_traits<ConstRandomAccessIterator>::difference_type element_count, Predicate p)
         {
+            typedef typename std::remove_const<typename std::iterator_traits<ConstRandomAccessIterator>::value_type>::type T;
             static const int tile_size = 512;
 
             auto input_view = _details::create_section(first, element_count);
@@ -436,12 +551,12 @@ namespace amp_stl_algorithms
             {
                 const int idx = tidx.global[0];
                 const int i = tidx.local[0];
-                tile_static unsigned local_buffer[tile_size + 1];
+                tile_static T local_buffer[tile_size + 1];
 
-                local_buffer[i] = padded_read(input_view, idx);
+                local_buffer[i] = amp_algorithms::padded_read(input_view, idx);
                 if (i == (tile_size - 1))
                 {
-                    local_buffer[i + 1] = padded_read(input_view, (idx + 1));
+                    local_buffer[i + 1] = amp_algorithms::padded_read(input_view, (idx + 1));
                 }
 
                 tidx.barrier.wait_with_all_memory_fence();
@@ -473,7 +588,7 @@ namespace amp_stl_algorithms
     template<typename ConstRandomAccessIterator>
     ConstRandomAccessIterator adjacent_find (ConstRandomAccessIterator first, ConstRandomAccessIterator last)
     {
-        typedef std::iterator_traits<ConstRandomAccessIterator>::value_type T;
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::value_type T;
         return amp_stl_algorithms::adjacent_find(first, last, amp_algorithms::equal_to<T>());
     }
 
@@ -484,7 +599,7 @@ namespace amp_stl_algorithms
     template< typename ConstRandomAccessIterator, typename UnaryFunction >
     void for_each_no_return( ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryFunction f )
     {	
-        typedef std::iterator_traits<ConstRandomAccessIterator>::difference_type difference_type;
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type difference_type;
 
         difference_type element_count = std::distance(first, last);
         if (element_count <= 0) 
@@ -540,7 +655,7 @@ namespace amp_stl_algorithms
     template <typename RandomAccessIterator, typename Generator>
     void generate(RandomAccessIterator begin, RandomAccessIterator end, Generator g)
     {
-        typedef std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
 
         difference_type element_count = std::distance(begin, end);
 
@@ -562,7 +677,7 @@ namespace amp_stl_algorithms
     template<typename RandomAccessIterator, typename T>
     void iota( RandomAccessIterator first, RandomAccessIterator last, T value)
     {
-        typedef std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
         const int tile_size = 512;
 
         difference_type element_count = std::distance(first, last);
@@ -576,11 +691,15 @@ namespace amp_stl_algorithms
         auto inc = T();
         inc = ++inc - T();
         auto section_view = _details::create_section(first, element_count);
+        const int size = int(element_count);
 
         concurrency::parallel_for_each(concurrency::tiled_extent<tile_size>(section_view.extent).pad(), [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
         {
             int idx = tidx.global[0];
-            section_view[idx] = value + (T(idx) * inc);  // Hum... Is this numerically equivalent to incrementing?
+            if (idx < size)
+            {
+                section_view[idx] = value + (T(idx) * inc);  // Hum... Is this numerically equivalent to incrementing?
+            }
         });
     }
 
@@ -592,10 +711,167 @@ namespace amp_stl_algorithms
     // lower_bound, upper_bound
     //----------------------------------------------------------------------------
 
+    template<typename ConstRandomAccessIterator, typename T, typename Compare>
+    ConstRandomAccessIterator lower_bound( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        const T& value, Compare comp )
+    {
+        return first + _details::search<amp_algorithms::_details::search_result::lower_bound>(first, last, value, comp);
+    }
+
+    template<typename ConstRandomAccessIterator, typename T>
+    ConstRandomAccessIterator lower_bound( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        const T& value )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::value_type value_type;
+        return amp_stl_algorithms::lower_bound(first, last, value, amp_algorithms::less<value_type>());
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator lower_bound( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result,
+        Compare comp )
+    {
+        return _details::batched_search<amp_algorithms::_details::search_result::lower_bound>(first, last, values_first, values_last, result, comp);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator>
+    RandomAccessIterator lower_bound( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        return amp_stl_algorithms::lower_bound(first, last, values_first, values_last, result, amp_algorithms::less<T>());
+    }
+
+    template<typename ConstRandomAccessIterator, typename T, typename Compare>
+    ConstRandomAccessIterator upper_bound( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        const T& value, Compare comp )
+    {
+        return first + _details::search<amp_algorithms::_details::search_result::upper_bound>(first, last, value, comp);
+    }
+
+    template<typename ConstRandomAccessIterator, typename T>
+    ConstRandomAccessIterator upper_bound( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        const T& value )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::value_type value_type;
+        return amp_stl_algorithms::upper_bound(first, last, value, amp_algorithms::less<value_type>());
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator upper_bound( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result,
+        Compare comp )
+    {
+        return _details::batched_search<amp_algorithms::_details::search_result::upper_bound>(first, last, values_first, values_last, result, comp);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator>
+    RandomAccessIterator upper_bound( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        return amp_stl_algorithms::upper_bound(first, last, values_first, values_last, result, amp_algorithms::less<T>());
+    }
+
     //----------------------------------------------------------------------------
     // merge, inplace_merge
     //----------------------------------------------------------------------------
 
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename BinaryPredicate>
+    RandomAccessIterator merge( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2, 
+        RandomAccessIterator result,
+        BinaryPredicate comp)
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::difference_type diff_type;
+
+        const diff_type element_count1 = std::distance(first1, last1);
+        const diff_type element_count2 = std::distance(first2, last2);
+        const diff_type element_count = element_count1 + element_count2;
+        if (element_count <= 0)
+        {
+            return result;
+        }
+
+        // Empty sections are not allowed, so an empty input is a copy of the other one.
+        if (element_count1 == 0)
+        {
+            return amp_stl_algorithms::copy(first2, last2, result);
+        }
+        if (element_count2 == 0)
+        {
+            return amp_stl_algorithms::copy(first1, last1, result);
+        }
+
+        auto src_view1 = _details::create_section(first1, element_count1);
+        auto src_view2 = _details::create_section(first2, element_count2);
+        auto dest_view = _details::create_section(result, element_count);
+        dest_view.discard_data();
+        amp_algorithms::_details::merge<amp_algorithms::_details::merge_tile_size, amp_algorithms::_details::merge_items_per_thread>(
+            amp_algorithms::_details::auto_select_target(), src_view1, src_view2, dest_view, comp);
+        return result + element_count;
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
+    RandomAccessIterator merge( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2, 
+        RandomAccessIterator result)
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        return amp_stl_algorithms::merge(first1, last1, first2, last2, result, amp_algorithms::less<T>());
+    }
+
+    // The two ranges are merged into a temporary buffer, which is then copied back.
+    template<typename RandomAccessIterator, typename Compare>
+    void inplace_merge( RandomAccessIterator first,
+        RandomAccessIterator middle,
+        RandomAccessIterator last,
+        Compare comp )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type diff_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+        const diff_type element_count = std::distance(first, last);
+        if ((first == middle) || (middle == last))
+        {
+            return;
+        }
+
+        amp_algorithms::_details::scratch_buffer<T> tmp(amp_algorithms::_details::auto_select_target(), int(element_count));
+        concurrency::array_view<T> tmp_view = tmp.view();
+        amp_stl_algorithms::merge(first, middle, middle, last, begin(tmp_view), comp);
+        amp_stl_algorithms::copy(begin(tmp_view), end(tmp_view), first);
+    }
+
+    template<typename RandomAccessIterator>
+    void inplace_merge( RandomAccessIterator first,
+        RandomAccessIterator middle,
+        RandomAccessIterator last )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        amp_stl_algorithms::inplace_merge(first, middle, last, amp_algorithms::less<T>());
+    }
+
     //----------------------------------------------------------------------------
     // max_element, min_element, minmax_element
     //----------------------------------------------------------------------------
@@ -604,14 +880,154 @@ namespace amp_stl_algorithms
     // mismatch
     //----------------------------------------------------------------------------
 
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename BinaryPredicate>
+    std::pair<ConstRandomAccessIterator1, ConstRandomAccessIterator2>
+        mismatch( ConstRandomAccessIterator1 first1,
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2,
+        BinaryPredicate p )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::difference_type diff_type;
+        diff_type element_count = std::distance(first1, last1);
+        if (element_count <= 0)
+        {
+            return std::make_pair(first1, first2);
+        }
+        const diff_type position = _details::mismatch(first1, element_count, first2, p);
+        return std::make_pair(first1 + position, first2 + position);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2>
+    std::pair<ConstRandomAccessIterator1, ConstRandomAccessIterator2>
+        mismatch( ConstRandomAccessIterator1 first1, ConstRandomAccessIterator1 last1, ConstRandomAccessIterator2 first2 )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+
+        return amp_stl_algorithms::mismatch(first1, last1, first2, [=](const T& v1, const T& v2) restrict(amp) { return (v1 == v2); });
+    }
+
     //----------------------------------------------------------------------------
     // move, move_backward
     //----------------------------------------------------------------------------
 
     //----------------------------------------------------------------------------
-    // nth_element
+    // nth_element, top_k
     //----------------------------------------------------------------------------
 
+    namespace _details
+    {
+        template <typename T, typename Compare>
+        void nth_element(concurrency::array_view<T>& view, const int nth, const Compare&, std::true_type)
+        {
+            const bool descending = std::is_same<Compare, amp_algorithms::greater<T>>::value;
+            const int element_count = view.extent[0];
+            const concurrency::accelerator_view accl_view = amp_algorithms::_details::auto_select_target();
+
+            auto selection = amp_algorithms::_details::radix_select<T>(accl_view, view, descending ? (element_count - 1 - nth) : nth);
+            amp_algorithms::_details::scratch_buffer<T> tmp(accl_view, element_count);
+            amp_algorithms::_details::radix_select_partition(accl_view, view, selection, descending, tmp.view());
+            concurrency::copy(tmp.view(), view);
+        }
+
+        // Keys that cannot be radix selected are sorted.
+        template <typename T, typename Compare>
+        void nth_element(concurrency::array_view<T>& view, const int, const Compare& comp, std::false_type)
+        {
+            amp_algorithms::merge_sort(view, comp);
+        }
+
+        // The k largest elements are those from the radix selected element of rank k from the end onwards, some of which
+        // may be equal to it. They are partitioned to the front of the output, and only the first k are kept.
+        template <typename T, typename InputIndexableView, typename Compare>
+        void top_k(const InputIndexableView& input_view, concurrency::array_view<T>& dest_view, const Compare&, std::true_type)
+        {
+            const bool is_less = std::is_same<Compare, amp_algorithms::less<T>>::value;
+            typedef typename std::conditional<is_less, amp_algorithms::greater<T>, amp_algorithms::less<T>>::type largest_first;
+            const int element_count = input_view.extent[0];
+            const int k = dest_view.extent[0];
+            const concurrency::accelerator_view accl_view = amp_algorithms::_details::auto_select_target();
+
+            auto selection = amp_algorithms::_details::radix_select<T>(accl_view, input_view, is_less ? (element_count - k) : (k - 1));
+            dest_view.discard_data();
+            amp_algorithms::_details::radix_select_partition(accl_view, input_view, selection, is_less, dest_view);
+            amp_stl_algorithms::sort(begin(dest_view), end(dest_view), largest_first());
+        }
+
+        template <typename T, typename InputIndexableView, typename Compare>
+        void top_k(const InputIndexableView& input_view, concurrency::array_view<T>& dest_view, const Compare& comp, std::false_type)
+        {
+            const int element_count = input_view.extent[0];
+            const int k = dest_view.extent[0];
+            const concurrency::accelerator_view accl_view = amp_algorithms::_details::auto_select_target();
+
+            amp_algorithms::_details::scratch_buffer<T> tmp(accl_view, element_count);
+            concurrency::array_view<T> tmp_view = tmp.view();
+            concurrency::copy(input_view, tmp_view);
+            amp_algorithms::merge_sort(tmp_view, comp);
+            amp_stl_algorithms::reverse_copy(end(tmp_view) - k, end(tmp_view), begin(dest_view));
+        }
+    }; // namespace _details
+
+    // Radix selects int, unsigned int and float keys compared with less or greater in a few histogram passes, anything
+    // else is sorted.
+    template<typename RandomAccessIterator, typename Compare>
+    void nth_element( RandomAccessIterator first, 
+        RandomAccessIterator nth,
+        RandomAccessIterator last, Compare comp )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type diff_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+        const diff_type element_count = std::distance(first, last);
+        if ((element_count <= 1) || (nth == last))
+        {
+            return;
+        }
+        auto section_view = _details::create_section(first, element_count);
+        _details::nth_element(section_view, int(std::distance(first, nth)), comp, typename _details::is_radix_sorted<T, Compare, false>::type());
+    }
+
+    template<typename RandomAccessIterator>
+    void nth_element( RandomAccessIterator first, 
+        RandomAccessIterator nth, 
+        RandomAccessIterator last )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        amp_stl_algorithms::nth_element(first, nth, last, amp_algorithms::less<T>());
+    }
+
+    template<typename ConstRandomAccessIterator, typename Size, typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator top_k( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        Size k,
+        RandomAccessIterator d_first,
+        Compare comp )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type diff_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+        const diff_type element_count = std::distance(first, last);
+        const diff_type copy_count = std::min(element_count, diff_type(k));
+        if (copy_count <= 0)
+        {
+            return d_first;
+        }
+        auto src_view = _details::create_section(first, element_count);
+        auto dest_view = _details::create_section(d_first, copy_count);
+        _details::top_k(src_view, dest_view, comp, typename _details::is_radix_sorted<T, Compare, false>::type());
+        return d_first + copy_count;
+    }
+
+    template<typename ConstRandomAccessIterator, typename Size, typename RandomAccessIterator>
+    RandomAccessIterator top_k( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        Size k,
+        RandomAccessIterator d_first )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        return amp_stl_algorithms::top_k(first, last, k, d_first, amp_algorithms::less<T>());
+    }
+
     //----------------------------------------------------------------------------
     // partial sum
     //----------------------------------------------------------------------------
@@ -620,6 +1036,78 @@ namespace amp_stl_algorithms
     // partition, stable_partition, partition_point, is_partitioned
     //----------------------------------------------------------------------------
 
+    // A range is partitioned if none of the elements after the first one for which p is false satisfy p.
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+    bool is_partitioned( ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p )
+    {
+        return amp_stl_algorithms::none_of(amp_stl_algorithms::find_if_not(first, last, p), last, p);
+    }
+
+    // The elements are partitioned into a temporary buffer by amp_algorithms::_details::partition and copied back.
+    template<typename RandomAccessIterator, typename UnaryPredicate>
+    RandomAccessIterator partition( RandomAccessIterator first, RandomAccessIterator last, UnaryPredicate p )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type diff_type;
+        typedef typename std::remove_const<typename std::iterator_traits<RandomAccessIterator>::value_type>::type T;
+
+        static const int tile_size = 512;
+        const diff_type element_count = std::distance(first, last);
+        if (element_count <= 0)
+        {
+            return first;
+        }
+        const concurrency::accelerator_view accl_view = amp_algorithms::_details::auto_select_target();
+        auto section_view = _details::create_section(first, element_count);
+        amp_algorithms::_details::scratch_buffer<T> tmp(accl_view, int(element_count));
+        concurrency::array_view<T> tmp_view = tmp.view();
+
+        const int true_count = amp_algorithms::_details::partition<tile_size>(accl_view, section_view, tmp_view, p);
+        concurrency::copy(tmp_view, section_view);
+        return first + true_count;
+    }
+
+    // The elements are compacted into a temporary buffer in a single pass, those for which p is true to its front and
+    // the others to its back in reverse order, see amp_algorithms::_details::compact. The copy back restores the
+    // order of the latter.
+    template<typename RandomAccessIterator, typename UnaryPredicate>
+    RandomAccessIterator stable_partition( RandomAccessIterator first, RandomAccessIterator last, UnaryPredicate p )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type diff_type;
+        typedef typename std::remove_const<typename std::iterator_traits<RandomAccessIterator>::value_type>::type T;
+
+        static const int tile_size = 512;
+        const diff_type element_count = std::distance(first, last);
+        if (element_count <= 0)
+        {
+            return first;
+        }
+        const concurrency::accelerator_view accl_view = amp_algorithms::_details::auto_select_target();
+        auto section_view = _details::create_section(first, element_count);
+        amp_algorithms::_details::scratch_buffer<T> tmp(accl_view, int(element_count));
+        concurrency::array_view<T> tmp_view = tmp.view();
+
+        const int true_count = amp_algorithms::_details::compact<tile_size, true>(accl_view, section_view, tmp_view,
+            [=](const int, T value) restrict(amp) { return (p(value) != 0); });
+
+        const int last_element = int(element_count) - 1;
+        amp_algorithms::_details::parallel_for_each(accl_view, section_view.extent, [=](concurrency::index<1> idx) restrict(amp)
+        {
+            const int i = idx[0];
+            section_view[idx] = tmp_view[(i < true_count) ? i : (true_count + last_element - i)];
+        });
+        return first + true_count;
+    }
+
+    // The partition point is the lower bound of a value that every element for which p is true is ordered before.
+    template<typename ConstRandomAccessIterator, typename UnaryPredicate>
+    ConstRandomAccessIterator partition_point( ConstRandomAccessIterator first, ConstRandomAccessIterator last, UnaryPredicate p )
+    {
+        typedef typename std::remove_const<typename std::iterator_traits<ConstRandomAccessIterator>::value_type>::type T;
+
+        return first + _details::search<amp_algorithms::_details::search_result::lower_bound>(first, last, T(),
+            [=](const T& element, const T&) restrict(amp) { return (p(element) != 0); });
+    }
+
     //----------------------------------------------------------------------------
     // reduce
     //----------------------------------------------------------------------------
@@ -637,7 +1125,7 @@ namespace amp_stl_algorithms
     template<typename ConstRandomAccessIterator, typename T>
     T reduce( ConstRandomAccessIterator first, ConstRandomAccessIterator last, T init )
     {
-        return amp_stl_algorithms::reduce(first, last, init, amp_algorithms::plus<std::remove_const<typename std::iterator_traits<ConstRandomAccessIterator>::value_type>::type>());
+        return amp_stl_algorithms::reduce(first, last, init, amp_algorithms::plus<typename std::remove_const<typename std::iterator_traits<ConstRandomAccessIterator>::value_type>::type>());
     }
 
     //----------------------------------------------------------------------------
@@ -650,34 +1138,23 @@ namespace amp_stl_algorithms
         return amp_stl_algorithms::remove_if(first, last, [=](const T& v) restrict(amp) { return (v == value) ? 1 : 0; });
     }
 
-    // TODO: Is is possible to remove elements in place and save having to copy?
+    // Elements are removed in place by compacting the range onto itself, see amp_algorithms::_details::compact.
     template<typename RandomAccessIterator, typename UnaryPredicate>
     RandomAccessIterator remove_if(RandomAccessIterator first, RandomAccessIterator last, UnaryPredicate p)
     {
         typedef typename std::iterator_traits<RandomAccessIterator>::difference_type diff_type;
         typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
 
+        static const int tile_size = 512;
         const diff_type element_count = std::distance(first, last);
         if (element_count <= 0)
         {
             return first;
         }
-        auto src_view = _details::create_section(first, element_count);
-
-        concurrency::array<T> tmp(element_count);
-        concurrency::array_view<T> tmp_view(tmp);
+        auto section_view = _details::create_section(first, element_count);
 
-        //  Here copy_if() is used with the predicate inverted
-        auto last_element =  amp_stl_algorithms::copy_if(first, last, begin(tmp_view), 
-            [p](const T& i) restrict(amp)
-        {
-            return static_cast<unsigned int>(!p(i));
-        });
-        const int remaining_elements = static_cast<int>(std::distance(begin(tmp_view), last_element));
-        if (remaining_elements > 0)
-        {
-            concurrency::copy(tmp_view.section(0, remaining_elements), src_view.section(0, remaining_elements));
-        }
+        const int remaining_elements = amp_algorithms::_details::compact<tile_size>(amp_algorithms::_details::auto_select_target(), section_view, section_view,
+            [=](const int, T value) restrict(amp) { return !p(value); });
         return first + remaining_elements;
     }
 
@@ -687,8 +1164,7 @@ namespace amp_stl_algorithms
         RandomAccessIterator dest_first,
         const T& value )
     {
-        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
-        return amp_stl_algorithms::copy_if(first, last, dest_first, [=](T& v) restrict(amp) { return (v != value); });
+        return amp_stl_algorithms::copy_if(first, last, dest_first, [=](const T& v) restrict(amp) { return (v != value); });
     }
 
     template<typename ConstRandomAccessIterator,typename RandomAccessIterator, typename UnaryPredicate>
@@ -711,8 +1187,6 @@ namespace amp_stl_algorithms
         const T& old_value, 
         const T& new_value )
     {
-        typedef std::iterator_traits<RandomAccessIterator>::value_type T;
-
         amp_stl_algorithms::replace_if(first, last, [=](const T& v) restrict(amp) { return (v == old_value); }, new_value);
     }
 
@@ -722,7 +1196,7 @@ namespace amp_stl_algorithms
         UnaryPredicate p, 
         const T& new_value )
     {
-        typedef std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
         const int tile_size = 512;
 
         difference_type element_count = std::distance(first, last);
@@ -760,7 +1234,7 @@ namespace amp_stl_algorithms
         UnaryPredicate p,
         const T& new_value )
     {
-        typedef std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
         const int tile_size = 512;
 
         difference_type element_count = std::distance(first, last);
@@ -812,12 +1286,13 @@ namespace amp_stl_algorithms
         }
         auto src_view = _details::create_section(first, element_count);
         const int last_element = element_count - 1;
+        const int swap_count = element_count >> 1;
 
-        concurrency::tiled_extent<tile_size> compute_domain = concurrency::extent<1>(element_count >> 1);
+        concurrency::tiled_extent<tile_size> compute_domain = concurrency::extent<1>(swap_count);
         concurrency::parallel_for_each(compute_domain.pad(), [=] (concurrency::tiled_index<tile_size> tidx) restrict(amp) 
         {
             const int idx = tidx.global[0];
-            if (idx < element_count)
+            if (idx < swap_count)
             {
                 amp_stl_algorithms::swap(src_view[idx], src_view[last_element - idx]);
             }
@@ -862,10 +1337,191 @@ namespace amp_stl_algorithms
     // search, search_n, binary_search
     //----------------------------------------------------------------------------
 
+    template<typename ConstRandomAccessIterator, typename T, typename Compare>
+    bool binary_search( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        const T& value, Compare comp )
+    {
+        return _details::search<amp_algorithms::_details::search_result::found>(first, last, value, comp) != 0;
+    }
+
+    template<typename ConstRandomAccessIterator, typename T>
+    bool binary_search( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        const T& value )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::value_type value_type;
+        return amp_stl_algorithms::binary_search(first, last, value, amp_algorithms::less<value_type>());
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator binary_search( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result,
+        Compare comp )
+    {
+        return _details::batched_search<amp_algorithms::_details::search_result::found>(first, last, values_first, values_last, result, comp);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator>
+    RandomAccessIterator binary_search( ConstRandomAccessIterator1 first, 
+        ConstRandomAccessIterator1 last,
+        ConstRandomAccessIterator2 values_first,
+        ConstRandomAccessIterator2 values_last,
+        RandomAccessIterator result )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        return amp_stl_algorithms::binary_search(first, last, values_first, values_last, result, amp_algorithms::less<T>());
+    }
+
     //----------------------------------------------------------------------------
     // set_difference, set_intersection, set_symetric_distance, set_union
     //----------------------------------------------------------------------------
 
+    namespace _details
+    {
+        // Set operations partition the inputs along the merge path and write the output in two passes, see
+        // amp_algorithms::_details::set_operation_count.
+        template<amp_algorithms::_details::set_operation Op, typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2, typename RandomAccessIterator, typename Compare>
+        RandomAccessIterator set_operation( ConstRandomAccessIterator1 first1, 
+            ConstRandomAccessIterator1 last1,
+            ConstRandomAccessIterator2 first2, 
+            ConstRandomAccessIterator2 last2,
+            RandomAccessIterator d_first, 
+            Compare comp )
+        {
+            typedef typename std::iterator_traits<ConstRandomAccessIterator1>::difference_type diff_type;
+            static const int tile_size = amp_algorithms::_details::merge_tile_size;
+            static const int items_per_thread = amp_algorithms::_details::merge_items_per_thread;
+
+            const diff_type element_count1 = std::distance(first1, last1);
+            const diff_type element_count2 = std::distance(first2, last2);
+
+            // Empty sections are not allowed, so the result of an operation with an empty input is a copy of the
+            // other input or empty.
+            const bool keeps_first = (Op != amp_algorithms::_details::set_operation::set_intersection);
+            const bool keeps_second = (Op == amp_algorithms::_details::set_operation::set_union) || (Op == amp_algorithms::_details::set_operation::set_symmetric_difference);
+            if ((element_count1 <= 0) || (element_count2 <= 0))
+            {
+                if ((element_count1 > 0) && keeps_first)
+                {
+                    return amp_stl_algorithms::copy(first1, last1, d_first);
+                }
+                if ((element_count2 > 0) && keeps_second)
+                {
+                    return amp_stl_algorithms::copy(first2, last2, d_first);
+                }
+                return d_first;
+            }
+
+            const concurrency::accelerator_view accl_view = amp_algorithms::_details::auto_select_target();
+            auto src_view1 = _details::create_section(first1, element_count1);
+            auto src_view2 = _details::create_section(first2, element_count2);
+            const int tile_count = amp_algorithms::_details::set_operation_tile_count<tile_size, items_per_thread>(int(element_count1), int(element_count2));
+            amp_algorithms::_details::scratch_buffer<unsigned int> tile_offsets(accl_view, tile_count);
+
+            const int output_count = amp_algorithms::_details::set_operation_count<tile_size, items_per_thread, Op>(accl_view, src_view1, src_view2, tile_offsets.view(), comp);
+            if (output_count == 0)
+            {
+                return d_first;
+            }
+            auto dest_view = _details::create_section(d_first, output_count);
+            dest_view.discard_data();
+            amp_algorithms::_details::set_operation_write<tile_size, items_per_thread, Op>(accl_view, src_view1, src_view2, tile_offsets.view(), dest_view, comp);
+            return d_first + output_count;
+        }
+    }; // namespace _details
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator set_difference( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2,
+        RandomAccessIterator d_first, 
+        Compare comp )
+    {
+        return _details::set_operation<amp_algorithms::_details::set_operation::set_difference>(first1, last1, first2, last2, d_first, comp);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
+    RandomAccessIterator set_difference( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2,
+        RandomAccessIterator d_first )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        return amp_stl_algorithms::set_difference(first1, last1, first2, last2, d_first, amp_algorithms::less<T>());
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator set_intersection( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2,
+        RandomAccessIterator d_first, 
+        Compare comp )
+    {
+        return _details::set_operation<amp_algorithms::_details::set_operation::set_intersection>(first1, last1, first2, last2, d_first, comp);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
+    RandomAccessIterator set_intersection( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2,
+        RandomAccessIterator d_first )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        return amp_stl_algorithms::set_intersection(first1, last1, first2, last2, d_first, amp_algorithms::less<T>());
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator set_symmetric_difference( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2,
+        RandomAccessIterator d_first, 
+        Compare comp )
+    {
+        return _details::set_operation<amp_algorithms::_details::set_operation::set_symmetric_difference>(first1, last1, first2, last2, d_first, comp);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
+    RandomAccessIterator set_symmetric_difference( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2,
+        RandomAccessIterator d_first )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        return amp_stl_algorithms::set_symmetric_difference(first1, last1, first2, last2, d_first, amp_algorithms::less<T>());
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator set_union( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2,
+        RandomAccessIterator d_first, 
+        Compare comp )
+    {
+        return _details::set_operation<amp_algorithms::_details::set_operation::set_union>(first1, last1, first2, last2, d_first, comp);
+    }
+
+    template<typename ConstRandomAccessIterator1, typename ConstRandomAccessIterator2,typename RandomAccessIterator>
+    RandomAccessIterator set_union( ConstRandomAccessIterator1 first1, 
+        ConstRandomAccessIterator1 last1,
+        ConstRandomAccessIterator2 first2, 
+        ConstRandomAccessIterator2 last2,
+        RandomAccessIterator d_first )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::value_type T;
+        return amp_stl_algorithms::set_union(first1, last1, first2, last2, d_first, amp_algorithms::less<T>());
+    }
+
     //----------------------------------------------------------------------------
     // shuffle, random_shuffle, 
     //----------------------------------------------------------------------------
@@ -909,6 +1565,145 @@ namespace amp_stl_algorithms
         return amp_stl_algorithms::is_sorted_until(first, last, amp_algorithms::less_equal<T>());
     }
 
+    namespace _details
+    {
+        template <typename T, typename Compare>
+        void sort(concurrency::array_view<T>& view, const Compare&, std::true_type)
+        {
+            amp_algorithms::radix_sort(view);
+            if (std::is_same<Compare, amp_algorithms::greater<T>>::value)
+            {
+                amp_stl_algorithms::reverse(begin(view), end(view));
+            }
+        }
+
+        template <typename T, typename Compare>
+        void sort(concurrency::array_view<T>& view, const Compare& comp, std::false_type)
+        {
+            amp_algorithms::merge_sort(view, comp);
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare>
+    void sort( RandomAccessIterator first, RandomAccessIterator last, Compare comp )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type diff_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+        const diff_type element_count = std::distance(first, last);
+        if (element_count <= 1)
+        {
+            return;
+        }
+        auto section_view = _details::create_section(first, element_count);
+        _details::sort(section_view, comp, typename _details::is_radix_sorted<T, Compare, false>::type());
+    }
+
+    template<typename RandomAccessIterator>
+    void sort( RandomAccessIterator first, RandomAccessIterator last )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        amp_stl_algorithms::sort(first, last, amp_algorithms::less<T>());
+    }
+
+    template<typename RandomAccessIterator, typename Compare>
+    void stable_sort( RandomAccessIterator first, RandomAccessIterator last, Compare comp )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type diff_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+        const diff_type element_count = std::distance(first, last);
+        if (element_count <= 1)
+        {
+            return;
+        }
+        auto section_view = _details::create_section(first, element_count);
+        _details::sort(section_view, comp, typename _details::is_radix_sorted<T, Compare, true>::type());
+    }
+
+    template<typename RandomAccessIterator>
+    void stable_sort( RandomAccessIterator first, RandomAccessIterator last )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        amp_stl_algorithms::stable_sort(first, last, amp_algorithms::less<T>());
+    }
+
+    namespace _details
+    {
+        // Radix selection moves the smallest elements to the start, which are then sorted.
+        template <typename RandomAccessIterator, typename Compare>
+        void partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, const Compare& comp, std::true_type)
+        {
+            amp_stl_algorithms::nth_element(first, middle, last, comp);
+            amp_stl_algorithms::sort(first, middle, comp);
+        }
+
+        // nth_element would merge sort the whole range for these keys, so a single sort does all the work.
+        template <typename RandomAccessIterator, typename Compare>
+        void partial_sort(RandomAccessIterator first, RandomAccessIterator, RandomAccessIterator last, const Compare& comp, std::false_type)
+        {
+            amp_stl_algorithms::sort(first, last, comp);
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare>
+    void partial_sort( RandomAccessIterator first, 
+        RandomAccessIterator middle,
+        RandomAccessIterator last, Compare comp )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+        if (first == middle)
+        {
+            return;
+        }
+        _details::partial_sort(first, middle, last, comp, typename _details::is_radix_sorted<T, Compare, false>::type());
+    }
+
+    template<typename RandomAccessIterator>
+    void partial_sort( RandomAccessIterator first, 
+        RandomAccessIterator middle, 
+        RandomAccessIterator last )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        amp_stl_algorithms::partial_sort(first, middle, last, amp_algorithms::less<T>());
+    }
+
+    template<typename ConstRandomAccessIterator,typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator partial_sort_copy( ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last,
+        RandomAccessIterator d_first, 
+        RandomAccessIterator d_last,
+        Compare comp )
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type diff_type;
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+        const diff_type element_count = std::distance(first, last);
+        const diff_type copy_count = std::min(element_count, std::distance(d_first, d_last));
+        if (copy_count <= 0)
+        {
+            return d_first;
+        }
+
+        // Sort a copy of the input so the input is left unchanged.
+        amp_algorithms::_details::scratch_buffer<T> tmp(amp_algorithms::_details::auto_select_target(), int(element_count));
+        concurrency::array_view<T> tmp_view = tmp.view();
+        amp_stl_algorithms::copy(first, last, begin(tmp_view));
+        amp_stl_algorithms::sort(begin(tmp_view), end(tmp_view), comp);
+        return amp_stl_algorithms::copy(begin(tmp_view), begin(tmp_view) + copy_count, d_first);
+    }
+
+    template<typename ConstRandomAccessIterator,typename RandomAccessIterator>
+    RandomAccessIterator partial_sort_copy( ConstRandomAccessIterator first,
+        ConstRandomAccessIterator last,
+        RandomAccessIterator d_first, 
+        RandomAccessIterator d_last )
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        return amp_stl_algorithms::partial_sort_copy(first, last, d_first, d_last, amp_algorithms::less<T>());
+    }
+
     //----------------------------------------------------------------------------
     // swap, swap<T, N>, swap_ranges, iter_swap
     //----------------------------------------------------------------------------
@@ -935,8 +1730,8 @@ namespace amp_stl_algorithms
         RandomAccessIterator1 last1, 
         RandomAccessIterator2 first2 )
     {
-        typedef std::iterator_traits<RandomAccessIterator1>::difference_type difference_type;
-        typedef std::iterator_traits<RandomAccessIterator1>::value_type T;
+        typedef typename std::iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+        typedef typename std::iterator_traits<RandomAccessIterator1>::value_type T;
         const int tile_size = 512;
 
         difference_type element_count = std::distance(first1, last1);
@@ -979,7 +1774,7 @@ namespace amp_stl_algorithms
         RandomAccessIterator result_begin,
         UnaryFunction func)
     {
-        typedef std::iterator_traits<ConstRandomAccessIterator>::difference_type difference_type;
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type difference_type;
 
         difference_type element_count = std::distance(begin1, end1);
         if (element_count <= 0)
@@ -1006,7 +1801,7 @@ namespace amp_stl_algorithms
         RandomAccessIterator result_begin,
         BinaryFunction func)
     {
-        typedef std::iterator_traits<ConstRandomAccessIterator1>::difference_type difference_type;
+        typedef typename std::iterator_traits<ConstRandomAccessIterator1>::difference_type difference_type;
 
         difference_type element_count = std::distance(begin1, end1);
         if (element_count <= 0)
@@ -1028,4 +1823,70 @@ namespace amp_stl_algorithms
     // unique, unique_copy
     //----------------------------------------------------------------------------
 
+    namespace _details
+    {
+        // An element is kept if it is the first one or is not equivalent to the element before it, so as for std::unique
+        // p must be an equivalence relation. The flags and the compaction are computed in a single pass, see
+        // amp_algorithms::_details::compact. The element before the first one of a tile can only be overwritten with
+        // its own value, so output_view may be input_view.
+        template<typename InputIndexableView, typename OutputIndexableView, typename BinaryPredicate>
+        int unique(const InputIndexableView& input_view, const OutputIndexableView& output_view, BinaryPredicate p)
+        {
+            typedef typename std::remove_const<typename InputIndexableView::value_type>::type T;
+
+            static const int tile_size = 512;
+            return amp_algorithms::_details::compact<tile_size>(amp_algorithms::_details::auto_select_target(), input_view, output_view,
+                [=](const int idx, T value) restrict(amp) { return (idx == 0) || !p(input_view[idx - 1], value); });
+        }
+    }
+
+    template<typename RandomAccessIterator, typename BinaryPredicate>
+    RandomAccessIterator unique(RandomAccessIterator first, RandomAccessIterator last, BinaryPredicate p)
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::difference_type diff_type;
+
+        const diff_type element_count = std::distance(first, last);
+        if (element_count <= 1)
+        {
+            return last;
+        }
+        auto section_view = _details::create_section(first, element_count);
+
+        return first + _details::unique(section_view, section_view, p);
+    }
+
+    template<typename RandomAccessIterator>
+    RandomAccessIterator unique(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+        return amp_stl_algorithms::unique(first, last, amp_algorithms::equal_to<T>());
+    }
+
+    template<typename ConstRandomAccessIterator, typename RandomAccessIterator, typename BinaryPredicate>
+    RandomAccessIterator unique_copy(ConstRandomAccessIterator first, 
+        ConstRandomAccessIterator last, 
+        RandomAccessIterator dest_first, 
+        BinaryPredicate p)
+    {
+        typedef typename std::iterator_traits<ConstRandomAccessIterator>::difference_type diff_type;
+
+        const diff_type element_count = std::distance(first, last);
+        if (element_count <= 0)
+        {
+            return dest_first;
+        }
+        auto src_view = _details::create_section(first, element_count);
+        auto dest_view = _details::create_section(dest_first, element_count);
+
+        return dest_first + _details::unique(src_view, dest_view, p);
+    }
+
+    template<typename ConstRandomAccessIterator, typename RandomAccessIterator>
+    RandomAccessIterator unique_copy(ConstRandomAccessIterator first, ConstRandomAccessIterator last, RandomAccessIterator dest_first)
+    {
+        typedef typename std::remove_const<typename std::iterator_traits<RandomAccessIterator>::value_type>::type T;
+        return amp_stl_algorithms::unique_copy(first, last, dest_first, amp_algorithms::equal_to<T>());
+    }
 }// namespace amp_stl_algorithms
+
+#include <xx_amp_algorithms_host_keywords_pop.h>
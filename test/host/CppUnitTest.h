@@ -0,0 +1,289 @@
+/*----------------------------------------------------------------------------
+* Copyright (c) Microsoft Corp.
+*
+* Licensed under the Apache License, Version 2.0 (the "License"); you may not
+* use this file except in compliance with the License.  You may obtain a copy
+* of the License at http://www.apache.org/licenses/LICENSE-2.0
+*
+* THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED
+* WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE,
+* MERCHANTABLITY OR NON-INFRINGEMENT.
+*
+* See the Apache Version 2.0 License for specific language governing
+* permissions and limitations under the License.
+*---------------------------------------------------------------------------
+*
+* C++ AMP algorithms library.
+*
+* This file provides the subset of the Visual Studio C++ unit test framework
+* used by the tests, so that they can be built with the host backend on
+* platforms without Visual Studio, see CMakeLists.txt. The tests register
+* themselves and host_test_main.cpp runs them.
+*---------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef TEXT
+#define TEXT(x) x
+#endif
+
+namespace Microsoft
+{
+    namespace VisualStudio
+    {
+        namespace CppUnitTestFramework
+        {
+            namespace _details
+            {
+                template <typename T, typename = void>
+                struct is_streamable : std::false_type
+                {
+                };
+
+                template <typename T>
+                struct is_streamable<T, decltype(void(std::declval<std::wostream&>() << std::declval<const T&>()))> : std::true_type
+                {
+                };
+
+                template <typename T>
+                std::wstring to_string(const T& value, std::true_type)
+                {
+                    std::wstringstream str;
+                    str << value;
+                    return str.str();
+                }
+
+                template <typename T>
+                std::wstring to_string(const T&, std::false_type)
+                {
+                    return L"<value>";
+                }
+
+                inline std::string narrow(const std::wstring& str)
+                {
+                    std::string result;
+                    for (wchar_t c : str)
+                    {
+                        result += (c < 128) ? char(c) : '?';
+                    }
+                    return result;
+                }
+            } // namespace _details
+
+            // Tests specialize ToString for the types they compare that cannot be written to a stream.
+            template <typename Q>
+            std::wstring ToString(const Q& q)
+            {
+                return _details::to_string(q, _details::is_streamable<Q>());
+            }
+
+            class test_failure : public std::runtime_error
+            {
+            public:
+                explicit test_failure(const std::string& message) : std::runtime_error(message)
+                {
+                }
+            };
+
+            struct __LineInfo
+            {
+            };
+
+            class Logger
+            {
+            public:
+                static void WriteMessage(const char*)
+                {
+                }
+
+                static void WriteMessage(const wchar_t*)
+                {
+                }
+            };
+
+            class Assert
+            {
+            public:
+                template <typename T>
+                static void AreEqual(const T& expected, const T& actual, const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    if (!(expected == actual))
+                    {
+                        Fail(L"AreEqual failed, expected <" + ToString(expected) + L"> actual <" + ToString(actual) + L">", message);
+                    }
+                }
+
+                static void AreEqual(double expected, double actual, double tolerance, const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    if (std::abs(expected - actual) > std::abs(tolerance))
+                    {
+                        Fail(L"AreEqual failed, expected <" + ToString(expected) + L"> actual <" + ToString(actual) + L">", message);
+                    }
+                }
+
+                static void AreEqual(float expected, float actual, float tolerance, const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    AreEqual(double(expected), double(actual), double(tolerance), message);
+                }
+
+                static void AreEqual(const char* expected, const char* actual, const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    if (std::strcmp(expected, actual) != 0)
+                    {
+                        Fail(L"AreEqual failed for strings", message);
+                    }
+                }
+
+                template <typename T>
+                static void AreNotEqual(const T& not_expected, const T& actual, const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    if (not_expected == actual)
+                    {
+                        Fail(L"AreNotEqual failed, both are <" + ToString(actual) + L">", message);
+                    }
+                }
+
+                static void IsTrue(bool condition, const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    if (!condition)
+                    {
+                        Fail(L"IsTrue failed", message);
+                    }
+                }
+
+                static void IsFalse(bool condition, const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    if (condition)
+                    {
+                        Fail(L"IsFalse failed", message);
+                    }
+                }
+
+                static void Fail(const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    Fail(L"Fail", message);
+                }
+
+                template <typename _Expected, typename _Func>
+                static void ExpectException(_Func functor, const wchar_t* message = nullptr, const __LineInfo* = nullptr)
+                {
+                    try
+                    {
+                        functor();
+                    }
+                    catch (const _Expected&)
+                    {
+                        return;
+                    }
+                    catch (...)
+                    {
+                        Fail(L"ExpectException failed, a different exception was thrown", message);
+                    }
+                    Fail(L"ExpectException failed, no exception was thrown", message);
+                }
+
+            private:
+                static void Fail(const std::wstring& failure, const wchar_t* message)
+                {
+                    throw test_failure(_details::narrow((message == nullptr) ? failure : (failure + L" - " + message)));
+                }
+            };
+
+            //----------------------------------------------------------------------------
+            // Test registration
+            //----------------------------------------------------------------------------
+
+            // Identifies the test class of a method, the address of TestClass<T>::__test_class_id.
+            typedef void (*test_class_id)();
+
+            struct test_method_info
+            {
+                test_class_id test_class;
+                const char* name;
+                std::function<void()> run;
+            };
+
+            struct test_registry
+            {
+                std::vector<test_method_info> methods;
+                std::vector<std::pair<test_class_id, std::function<void()>>> class_initializers;
+
+                static test_registry& instance()
+                {
+                    static test_registry registry;
+                    return registry;
+                }
+            };
+
+            struct test_method_registration
+            {
+                test_method_registration(test_class_id test_class, const char* name, void (*run)())
+                {
+                    test_registry::instance().methods.push_back({ test_class, name, run });
+                }
+            };
+
+            struct test_class_initializer_registration
+            {
+                test_class_initializer_registration(test_class_id test_class, void (*run)())
+                {
+                    test_registry::instance().class_initializers.push_back(std::make_pair(test_class, std::function<void()>(run)));
+                }
+            };
+
+            template <typename T>
+            class TestClass
+            {
+            protected:
+                typedef T __test_class;
+
+                static void __test_class_id()
+                {
+                }
+            };
+        } // namespace CppUnitTestFramework
+    } // namespace VisualStudio
+} // namespace Microsoft
+
+#define TEST_CLASS(className) \
+    class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className>
+
+#define TEST_METHOD(methodName)                                                                             \
+    static void __run_##methodName()                                                                        \
+    {                                                                                                       \
+        __test_class test;                                                                                  \
+        test.methodName();                                                                                  \
+    }                                                                                                       \
+    static inline ::Microsoft::VisualStudio::CppUnitTestFramework::test_method_registration                 \
+        __register_##methodName{ &__test_class_id, #methodName, &__run_##methodName };                  \
+    public:                                                                                                 \
+    void methodName()
+
+#define TEST_CLASS_INITIALIZE(methodName)                                                                   \
+    static void __run_##methodName()                                                                        \
+    {                                                                                                       \
+        __test_class::methodName();                                                                         \
+    }                                                                                                       \
+    static inline ::Microsoft::VisualStudio::CppUnitTestFramework::test_class_initializer_registration      \
+        __register_##methodName{ &__test_class_id, &__run_##methodName };                               \
+    public:                                                                                                 \
+    static void methodName()
+
+#define BEGIN_TEST_METHOD_ATTRIBUTE(methodName)
+#define TEST_METHOD_ATTRIBUTE(attributeName, attributeValue)
+#define TEST_IGNORE()
+#define END_TEST_METHOD_ATTRIBUTE()
+#define BEGIN_TEST_CLASS_ATTRIBUTE()
+#define TEST_CLASS_ATTRIBUTE(attributeName, attributeValue)
+#define END_TEST_CLASS_ATTRIBUTE()
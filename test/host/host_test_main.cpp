@@ -0,0 +1,93 @@
+/*----------------------------------------------------------------------------
+* Copyright (c) Microsoft Corp.
+*
+* Licensed under the Apache License, Version 2.0 (the "License"); you may not
+* use this file except in compliance with the License.  You may obtain a copy
+* of the License at http://www.apache.org/licenses/LICENSE-2.0
+*
+* THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED
+* WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE,
+* MERCHANTABLITY OR NON-INFRINGEMENT.
+*
+* See the Apache Version 2.0 License for specific language governing
+* permissions and limitations under the License.
+*---------------------------------------------------------------------------
+*
+* C++ AMP algorithms library.
+*
+* Runs the tests built with the host backend. Runs every test, or the tests
+* whose names contain one of the arguments, and returns the number of failures.
+*---------------------------------------------------------------------------*/
+
+#include <CppUnitTest.h>
+
+#include <exception>
+#include <iostream>
+#include <set>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+    bool is_selected(const std::string& name, int argc, char** argv)
+    {
+        if (argc < 2)
+        {
+            return true;
+        }
+        for (int i = 1; i < argc; ++i)
+        {
+            if (name.find(argv[i]) != std::string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const test_registry& registry = test_registry::instance();
+    std::set<test_class_id> initialized_classes;
+    int run_count = 0;
+    int failure_count = 0;
+
+    for (const test_method_info& method : registry.methods)
+    {
+        if (!is_selected(method.name, argc, argv))
+        {
+            continue;
+        }
+
+        try
+        {
+            // Each test class is initialized before its first test, as the Visual Studio test runner does.
+            if (initialized_classes.insert(method.test_class).second)
+            {
+                for (const auto& initializer : registry.class_initializers)
+                {
+                    if (initializer.first == method.test_class)
+                    {
+                        initializer.second();
+                    }
+                }
+            }
+
+            ++run_count;
+            std::cout << method.name << " ... " << std::flush;
+            method.run();
+            std::cout << "passed" << std::endl;
+        }
+        catch (const std::exception& ex)
+        {
+            ++failure_count;
+            std::cout << "FAILED: " << ex.what() << std::endl;
+        }
+    }
+
+    std::cout << run_count << " tests run, " << failure_count << " failed." << std::endl;
+    return (failure_count == 0) ? 0 : 1;
+}
@@ -29,11 +29,13 @@
 #include <vector>
 
 // These are not required includes, they already included by the AMP library headers .
+#if !defined(AMP_ALGORITHMS_HOST_BACKEND)
 #include <amp.h>
-#include <assert.h>
 #include <wrl\client.h>
 #include <d3d11.h>
 #include <d3dcsx.h>
+#endif
+#include <assert.h>
 #include <iterator>
 #include <sstream>
 #include <type_traits>
@@ -258,5 +258,391 @@ namespace amp_algorithms_tests
             input_vw.synchronize();
             Assert::IsTrue(expected == input, Msg(expected, input).c_str());
         }
+
+        TEST_METHOD(amp_scan_exclusive_multi_pass)
+        {
+            const int tile_size = warp_size * 4;
+            std::vector<int> input(tile_size * (tile_size + 10));
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            scan_sequential_exclusive(begin(input), end(input), begin(expected));
+
+            amp_algorithms::_details::scan_multi_pass<warp_size, scan_mode::exclusive>(amp_algorithms::_details::auto_select_target(), input_vw, input_vw, amp_algorithms::plus<int>(), 0);
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_inclusive_multi_pass)
+        {
+            const int tile_size = warp_size * 4;
+            std::vector<int> input(tile_size * (tile_size + 10));
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            scan_sequential_inclusive(begin(input), end(input), begin(expected));
+
+            amp_algorithms::_details::scan_multi_pass<warp_size, scan_mode::inclusive>(amp_algorithms::_details::auto_select_target(), input_vw, input_vw, amp_algorithms::plus<int>(), 0);
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_exclusive_less_than_warp)
+        {
+            std::vector<int> input(warp_size - 1);
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            scan_sequential_exclusive(begin(input), end(input), begin(expected));
+
+            scan_exclusive(input_vw, input_vw);
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_inclusive_single_element)
+        {
+            std::vector<int> input(1, 7);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(1, 7);
+
+            scan_inclusive(input_vw, input_vw);
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_inclusive_single_tile_loop)
+        {
+            std::vector<int> input(amp_algorithms::_details::scan_single_tile_threshold);
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            scan_sequential_inclusive(begin(input), end(input), begin(expected));
+
+            scan_inclusive(input_vw, input_vw);
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_exclusive_max)
+        {
+            const int tile_size = warp_size * 4;
+            std::vector<int> input(tile_size * (tile_size + 10) + 3);
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            expected[0] = std::numeric_limits<int>::lowest();
+            std::partial_sum(begin(input), end(input) - 1, begin(expected) + 1, [](int a, int b) { return (std::max)(a, b); });
+
+            scan_exclusive(input_vw, input_vw, amp_algorithms::max<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_inclusive_min)
+        {
+            const int tile_size = warp_size * 4;
+            std::vector<int> input(tile_size * (tile_size + 10) + 3);
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            std::partial_sum(begin(input), end(input), begin(expected), [](int a, int b) { return (std::min)(a, b); });
+
+            scan_inclusive(input_vw, input_vw, amp_algorithms::min<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_inclusive_max_min_infinity)
+        {
+            // The identity of max and min for floating point types is an infinity, so infinite inputs scan to themselves.
+            const float infinity = std::numeric_limits<float>::infinity();
+            for (int size : { 1, 10, 5000, 70000 })
+            {
+                std::vector<float> input(size, -infinity);
+                concurrency::array_view<float, 1> input_vw(size, input);
+
+                scan_inclusive(input_vw, input_vw, amp_algorithms::max<float>());
+
+                input_vw.synchronize();
+                Assert::IsTrue(std::all_of(begin(input), end(input), [=](float v) { return v == -infinity; }));
+
+                std::fill(begin(input), end(input), infinity);
+                input_vw.refresh();
+
+                scan_inclusive(input_vw, input_vw, amp_algorithms::min<float>());
+
+                input_vw.synchronize();
+                Assert::IsTrue(std::all_of(begin(input), end(input), [=](float v) { return v == infinity; }));
+            }
+        }
+
+        TEST_METHOD(amp_scan_inclusive_bit_or)
+        {
+            const int tile_size = warp_size * 4;
+            std::vector<int> input(tile_size * (tile_size + 10) + 3);
+            std::generate(begin(input), end(input), [] { return 1 << (rand() % 31); });
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            std::partial_sum(begin(input), end(input), begin(expected), std::bit_or<int>());
+
+            scan<warp_size, scan_mode::inclusive>(input_vw, input_vw, amp_algorithms::bit_or<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_exclusive_multiplies)
+        {
+            const int tile_size = warp_size * 4;
+            std::vector<int> input(tile_size * (tile_size + 10) + 3);
+            std::generate(begin(input), end(input), [] { return ((rand() % 7) == 0) ? -1 : 1; });
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            expected[0] = 1;
+            std::partial_sum(begin(input), end(input) - 1, begin(expected) + 1, std::multiplies<int>());
+
+            scan<warp_size, scan_mode::exclusive>(input_vw, input_vw, amp_algorithms::multiplies<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_inclusive_explicit_identity)
+        {
+            const int tile_size = warp_size * 4;
+            std::vector<int> input(tile_size * (tile_size + 10) + 3);
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            std::partial_sum(begin(input), end(input), begin(expected), [](int a, int b) { return (std::max)(a, b); });
+
+            scan<warp_size, scan_mode::inclusive>(amp_algorithms::_details::auto_select_target(), input_vw, input_vw, amp_algorithms::max<int>(), std::numeric_limits<int>::lowest());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_exclusive_backward)
+        {
+            std::vector<int> input(warp_size * 4 * 70 + 5);
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            scan_sequential_exclusive(input.rbegin(), input.rend(), expected.rbegin());
+
+            scan_exclusive(input_vw, input_vw, scan_direction::backward, amp_algorithms::plus<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_inclusive_backward)
+        {
+            std::vector<int> input(warp_size * 4 * 70 + 5);
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            std::partial_sum(input.rbegin(), input.rend(), expected.rbegin(), [](int a, int b) { return (std::max)(a, b); });
+
+            scan_inclusive(input_vw, input_vw, scan_direction::backward, amp_algorithms::max<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_segmented_scan_exclusive)
+        {
+            std::vector<int> input(warp_size * 4 * 70 + 5);
+            generate_data(input);
+            std::vector<unsigned int> flags(input.size());
+            std::generate(begin(flags), end(flags), [] { return ((rand() % 37) == 0) ? 1u : 0u; });
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            concurrency::array_view<const unsigned int, 1> flags_vw(int(flags.size()), flags);
+            std::vector<int> expected(input.size());
+            int sum = 0;
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                if (flags[i] != 0)
+                    sum = 0;
+                expected[i] = sum;
+                sum += input[i];
+            }
+
+            segmented_scan_exclusive(input_vw, input_vw, flags_vw, amp_algorithms::plus<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_segmented_scan_inclusive_by_offsets)
+        {
+            std::vector<int> input(warp_size * 4 * 70 + 5);
+            generate_data(input);
+            std::vector<int> offsets;
+            for (int i = 0; i < int(input.size()); i += 1 + (rand() % 100))
+                offsets.push_back(i);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            concurrency::array_view<const int, 1> offsets_vw(int(offsets.size()), offsets);
+            std::vector<int> expected(input.size());
+            for (size_t i = 0, o = 0; i < input.size(); ++i)
+            {
+                const bool head = (o < offsets.size()) && (offsets[o] == int(i));
+                expected[i] = (head || (i == 0)) ? input[i] : (std::max)(expected[i - 1], input[i]);
+                if (head)
+                    ++o;
+            }
+
+            segmented_scan_inclusive_by_offsets(input_vw, input_vw, offsets_vw, amp_algorithms::max<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_multi_scan_exclusive_short_rows)
+        {
+            const int rows = 300;
+            const int cols = warp_size + 7;
+            std::vector<int> input(rows * cols);
+            generate_data(input);
+            concurrency::array_view<int, 2> input_vw(rows, cols, input);
+            std::vector<int> expected(input.size());
+            for (int r = 0; r < rows; ++r)
+                scan_sequential_exclusive(begin(input) + r * cols, begin(input) + (r + 1) * cols, begin(expected) + r * cols);
+
+            multi_scan_exclusive(input_vw, input_vw, amp_algorithms::plus<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_multi_scan_inclusive_long_rows)
+        {
+            const int rows = 7;
+            const int cols = max_tile_size * 3 + 5;
+            std::vector<int> input(rows * cols);
+            generate_data(input);
+            concurrency::array_view<int, 2> input_vw(rows, cols, input);
+            std::vector<int> expected(input.size());
+            for (int r = 0; r < rows; ++r)
+                scan_sequential_inclusive(begin(input) + r * cols, begin(input) + (r + 1) * cols, begin(expected) + r * cols);
+
+            multi_scan_inclusive(input_vw, input_vw, amp_algorithms::plus<int>());
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        TEST_METHOD(amp_scan_tile_tree)
+        {
+            const int tile_size = max_tile_size;
+            std::vector<int> input(tile_size * 20);
+            generate_data(input);
+            concurrency::array_view<int, 1> input_vw(int(input.size()), input);
+            std::vector<int> expected(input.size());
+            for (size_t i = 0; i < input.size(); i += tile_size)
+                scan_sequential_exclusive(begin(input) + i, begin(input) + i + tile_size, begin(expected) + i);
+
+            concurrency::parallel_for_each(input_vw.extent.tile<tile_size>(), [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
+            {
+                tile_static int tile_data[tile_size];
+                tile_data[tidx.local[0]] = input_vw[tidx.global];
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                input_vw[tidx.global] = amp_algorithms::_details::scan_tile_tree<tile_size, scan_mode::exclusive>(tile_data, tidx, amp_algorithms::plus<int>(), 0);
+            });
+
+            input_vw.synchronize();
+            Assert::IsTrue(expected == input, Msg(expected, input).c_str());
+        }
+
+        BEGIN_TEST_METHOD_ATTRIBUTE(amp_scan_tile_performance)
+            TEST_CATEGORY("amp")
+#if (defined(USE_REF) || defined(_DEBUG))
+            TEST_IGNORE()
+#endif
+        END_TEST_METHOD_ATTRIBUTE()
+        TEST_METHOD(amp_scan_tile_performance)
+        {
+            accelerator device(accelerator::default_accelerator);
+            accelerator_view view = device.default_view;
+            char buff[100];
+
+            const int tile_size = 512;
+            const int size = 2048 * 1088 * 5;
+            concurrency::array<int, 1> data(size, view);
+            array_view<int, 1> data_vw(data);
+            amp_algorithms::fill(view, data_vw, 1);
+
+            double t_warp = time_func(view, [&]()
+            {
+                concurrency::parallel_for_each(view, data_vw.extent.tile<tile_size>(), [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
+                {
+                    tile_static int tile_data[tile_size];
+                    tile_data[tidx.local[0]] = data_vw[tidx.global];
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+                    data_vw[tidx.global] = amp_algorithms::_details::scan_tile_warp<tile_size, scan_mode::exclusive>(tile_data, tidx, amp_algorithms::plus<int>(), 0);
+                });
+            });
+            double t_tree = time_func(view, [&]()
+            {
+                concurrency::parallel_for_each(view, data_vw.extent.tile<tile_size>(), [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
+                {
+                    tile_static int tile_data[tile_size];
+                    tile_data[tidx.local[0]] = data_vw[tidx.global];
+                    tidx.barrier.wait_with_tile_static_memory_fence();
+                    data_vw[tidx.global] = amp_algorithms::_details::scan_tile_tree<tile_size, scan_mode::exclusive>(tile_data, tidx, amp_algorithms::plus<int>(), 0);
+                });
+            });
+
+            sprintf_s<100>(buff, "Scanned %d tiles of %d elements", size / tile_size, tile_size);
+            Logger::WriteMessage(buff);
+            sprintf_s<100>(buff, "  warp synchronous %.1f ms", t_warp);
+            Logger::WriteMessage(buff);
+            sprintf_s<100>(buff, "  barrier tree     %.1f ms (%.2fx warp)", t_tree, t_tree / t_warp);
+            Logger::WriteMessage(buff);
+        }
+
+        BEGIN_TEST_METHOD_ATTRIBUTE(amp_scan_operator_performance)
+            TEST_CATEGORY("amp")
+#if (defined(USE_REF) || defined(_DEBUG))
+            TEST_IGNORE()
+#endif
+        END_TEST_METHOD_ATTRIBUTE()
+        TEST_METHOD(amp_scan_operator_performance)
+        {
+            accelerator device(accelerator::default_accelerator);
+            accelerator_view view = device.default_view;
+            char buff[100];
+
+            const int size = 2048 * 1088 * 5;
+            std::vector<int> input(size);
+            generate_data(input);
+            concurrency::array<int, 1> input_arr(size, input.begin(), view);
+            concurrency::array<int, 1> output_arr(size, view);
+            array_view<int, 1> input_vw(input_arr);
+            array_view<int, 1> output_vw(output_arr);
+
+            double t_plus = time_func(view, [&]() { scan_exclusive(view, input_vw, output_vw, amp_algorithms::plus<int>()); });
+            double t_max = time_func(view, [&]() { scan_exclusive(view, input_vw, output_vw, amp_algorithms::max<int>()); });
+            double t_min = time_func(view, [&]() { scan_exclusive(view, input_vw, output_vw, amp_algorithms::min<int>()); });
+            double t_bit_or = time_func(view, [&]() { scan_exclusive(view, input_vw, output_vw, amp_algorithms::bit_or<int>()); });
+
+            sprintf_s<100>(buff, "Scanned %d elements with plus in %.1f ms", size, t_plus);
+            Logger::WriteMessage(buff);
+            sprintf_s<100>(buff, "  max    %.1f ms (%.2fx plus)", t_max, t_max / t_plus);
+            Logger::WriteMessage(buff);
+            sprintf_s<100>(buff, "  min    %.1f ms (%.2fx plus)", t_min, t_min / t_plus);
+            Logger::WriteMessage(buff);
+            sprintf_s<100>(buff, "  bit_or %.1f ms (%.2fx plus)", t_bit_or, t_bit_or / t_plus);
+            Logger::WriteMessage(buff);
+        }
     };
 }
@@ -123,21 +123,216 @@ namespace amp_algorithms_tests
             Assert::IsTrue(are_equal(expected, input_av));
         }
 
-#ifdef _DEBUG
-        TEST_METHOD(amp_details_radix_sort_by_key)
+        TEST_METHOD(amp_details_radix_sort_tile_by_key_8_bit)
         {
-            std::array<unsigned, 16> input  =    { 1,  2,  6,  3,  0, 13, 10, 11,  5, 10, 14, 15,  4, 12,  8,  9 };
-            std::array<unsigned, 16> expected  = { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 };
-            std::array<unsigned, 16> output;
+            static const int tile_size = 1024;
+            std::vector<int> input(tile_size * 4);
+            generate_data(input);
+            std::transform(begin(input), end(input), begin(input), [](int v) { return std::abs(v); });
+            std::vector<int> expected(input);
+            for (auto it = begin(expected); it != end(expected); it += tile_size)
+            {
+                std::stable_sort(it, it + tile_size, [](int a, int b) { return radix_key_value<int, 8>(a, 1) < radix_key_value<int, 8>(b, 1); });
+            }
+            array_view<int> input_av(int(input.size()), input);
+
+            concurrency::parallel_for_each(input_av.extent.tile<tile_size>(), [=](concurrency::tiled_index<tile_size> tidx) restrict(amp)
+            {
+                tile_static int tile_data[tile_size];
+                tile_data[tidx.local[0]] = input_av[tidx.global];
+                tidx.barrier.wait_with_tile_static_memory_fence();
+
+                amp_algorithms::_details::radix_sort_tile_by_key<int, 8, tile_size>(tile_data, tidx, 1);
+
+                input_av[tidx.global] = tile_data[tidx.local[0]];
+            });
+            Assert::IsTrue(are_equal(expected, input_av));
+        }
+
+        TEST_METHOD(amp_merge_sort_int)
+        {
+            std::vector<int> input(test_array_size<int>());
+            generate_data(input);
+            std::vector<int> expected(input);
+            std::sort(begin(expected), end(expected));
+            array_view<int> input_av(int(input.size()), input);
+
+            amp_algorithms::merge_sort(input_av);
+
+            Assert::IsTrue(are_equal(expected, input_av));
+        }
+
+        TEST_METHOD(amp_merge_sort_composite_key_is_stable)
+        {
+            struct record
+            {
+                int timestamp;
+                int id;
+                int priority;
+            };
+
+            struct record_less
+            {
+                bool operator()(const record& a, const record& b) const restrict(cpu, amp)
+                {
+                    return (a.timestamp != b.timestamp) ? (a.timestamp < b.timestamp) : (a.priority > b.priority);
+                }
+            };
+
+            std::vector<record> input(test_array_size<int>());
+            srand(2012);
+            for (int i = 0; i < int(input.size()); ++i)
+            {
+                input[i].timestamp = rand() % 100;
+                input[i].id = i;
+                input[i].priority = rand() % 4;
+            }
+            std::vector<record> expected(input);
+            std::stable_sort(begin(expected), end(expected), record_less());
+            array_view<record> input_av(int(input.size()), input);
+
+            amp_algorithms::merge_sort(input_av, record_less());
+            input_av.synchronize();
+
+            for (int i = 0; i < int(input.size()); ++i)
+            {
+                Assert::AreEqual(expected[i].id, input[i].id);
+            }
+        }
+
+        TEST_METHOD(amp_radix_sort_int)
+        {
+            std::vector<int> input(test_array_size<int>());
+            generate_data(input);
+            std::vector<int> expected(input);
+            std::sort(begin(expected), end(expected));
+            array_view<int> input_av(int(input.size()), input);
+
+            amp_algorithms::radix_sort(input_av);
+
+            Assert::IsTrue(are_equal(expected, input_av));
+        }
+
+        TEST_METHOD(amp_radix_sort_unsigned_odd_pass_count)
+        {
+            std::vector<unsigned> input(test_array_size<unsigned>());
+            generate_data(input);
+            std::vector<unsigned> expected(input);
+            std::sort(begin(expected), end(expected));
             array_view<unsigned> input_av(int(input.size()), input);
-            array_view<unsigned> output_av(int(output.size()), output);
-            radix_sort_by_key<unsigned, 2, 4>(input_av, output_av, 0);
 
-            output_av.synchronize();
+            // 32 bits in 5 bit digits needs seven passes, so the result is copied back from the temporary buffer.
+            amp_algorithms::radix_sort<5>(input_av);
+
+            Assert::IsTrue(are_equal(expected, input_av));
+        }
+
+        TEST_METHOD(amp_radix_sort_float)
+        {
+            std::vector<float> input(test_array_size<float>());
+            generate_data(input);
+            std::vector<float> expected(input);
+            std::sort(begin(expected), end(expected));
+            array_view<float> input_av(int(input.size()), input);
+
+            amp_algorithms::radix_sort<8>(input_av);
+
+            Assert::IsTrue(are_equal(expected, input_av));
+        }
+
+        TEST_METHOD(amp_radix_sort_int64)
+        {
+            std::vector<long long> input(test_array_size<int>());
+            srand(2012);
+            std::generate(begin(input), end(input), []() { return (static_cast<long long>(rand() & 0x7FFF) << 40) - (static_cast<long long>(rand() & 0x7FFF) << 20) + (rand() & 0x7FFF); });
+            std::vector<long long> expected(input);
+            std::sort(begin(expected), end(expected));
+            array_view<int64_key> input_av(int(input.size()), reinterpret_cast<int64_key*>(input.data()));
+
+            amp_algorithms::radix_sort(input_av);
+            input_av.synchronize();
+
+            Assert::IsTrue(expected == input);
+        }
+
+        TEST_METHOD(amp_radix_sort_by_key)
+        {
+            std::array<unsigned, 16> keys =            { 1,  2,  6,  3,  0, 13, 10, 11,  5, 10, 14, 15,  4, 12,  8,  9 };
+            std::array<int, 16> values =               { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 };
+            std::array<unsigned, 16> expected_keys =   { 0,  1,  2,  3,  4,  5,  6,  8,  9, 10, 10, 11, 12, 13, 14, 15 };
+            std::array<int, 16> expected_values =      { 4,  0,  1,  3, 12,  8,  2, 14, 15,  6,  9,  7, 13,  5, 10, 11 };
+            array_view<unsigned> keys_av(int(keys.size()), keys);
+            array_view<int> values_av(int(values.size()), values);
+
+            amp_algorithms::radix_sort_by_key<2>(keys_av, values_av);
+
+            Assert::IsTrue(are_equal(expected_keys, keys_av));
+            Assert::IsTrue(are_equal(expected_values, values_av));
+        }
+
+        TEST_METHOD(amp_radix_sort_by_key_struct_values)
+        {
+            struct row
+            {
+                int id;
+                float weight;
+            };
 
-            Assert::IsTrue(are_equal(expected, output_av));
+            std::vector<int> keys(test_array_size<int>());
+            generate_data(keys);
+            std::vector<row> values(keys.size());
+            for (int i = 0; i < int(values.size()); ++i)
+            {
+                values[i].id = i;
+                values[i].weight = float(keys[i]);
+            }
+            std::vector<int> expected(keys.size());
+            std::iota(begin(expected), end(expected), 0);
+            std::stable_sort(begin(expected), end(expected), [&](int a, int b) { return keys[a] < keys[b]; });
+            array_view<int> keys_av(int(keys.size()), keys);
+            array_view<row> values_av(int(values.size()), values);
+
+            amp_algorithms::radix_sort_by_key(keys_av, values_av);
+            values_av.synchronize();
+
+            for (int i = 0; i < int(values.size()); ++i)
+            {
+                Assert::AreEqual(expected[i], values[i].id);
+                Assert::AreEqual(float(keys_av[i]), values[i].weight);
+            }
+        }
+
+        // Few distinct keys over many tiles, so most elements of each tile share their digit with many others and the
+        // 8 bit digits rank in several groups of digits.
+        TEST_METHOD(amp_radix_sort_by_key_equal_digits_multi_tile)
+        {
+            std::vector<unsigned> keys(test_array_size<unsigned>() * 4 + 1);
+            generate_data(keys);
+            std::transform(begin(keys), end(keys), begin(keys), [](unsigned k) { return (k % 5) * 0x01010101u + ((k % 7 == 0) ? 0x80u : 0u); });
+            std::vector<int> values(keys.size());
+            std::iota(begin(values), end(values), 0);
+            std::vector<int> expected(values);
+            std::stable_sort(begin(expected), end(expected), [&](int a, int b) { return keys[a] < keys[b]; });
+
+            for (int digit_width = 4; digit_width <= 8; digit_width += 4)
+            {
+                std::vector<unsigned> keys_copy(keys);
+                std::vector<int> values_copy(values);
+                array_view<unsigned> keys_av(int(keys_copy.size()), keys_copy);
+                array_view<int> values_av(int(values_copy.size()), values_copy);
+
+                if (digit_width == 4)
+                {
+                    amp_algorithms::radix_sort_by_key<4>(keys_av, values_av);
+                }
+                else
+                {
+                    amp_algorithms::radix_sort_by_key<8>(keys_av, values_av);
+                }
+
+                Assert::IsTrue(are_equal(expected, values_av));
+            }
         }
-#endif
     };
 }; // namespace amp_algorithms_tests
 
@@ -44,7 +44,7 @@ namespace Microsoft {
             // TODO: Are all these overloads required? Should be able to just have std::pair and rely on casting from amp_stl_algorithms::pair.
             // TODO: Might want to  move ToString overloads into testtools and templatize them.
             template<> 
-            static std::wstring ToString<std::pair<const int&, const int&>>(const std::pair<const int&, const int&>& v)
+            inline std::wstring ToString<std::pair<const int&, const int&>>(const std::pair<const int&, const int&>& v)
             { 
                 std::wstringstream str;
                 str << v.first << ", " << v.second;
@@ -52,7 +52,7 @@ namespace Microsoft {
             }
 
             template<> 
-            static std::wstring ToString<std::pair<int, int>>(const std::pair<int, int>& v)
+            inline std::wstring ToString<std::pair<int, int>>(const std::pair<int, int>& v)
             {
                 std::wstringstream str;
                 str << v.first << ", " << v.second;
@@ -60,7 +60,7 @@ namespace Microsoft {
             }
 
             template<>
-            static std::wstring ToString<std::pair<const int, const int>>(const std::pair<const int, const int>& v)
+            inline std::wstring ToString<std::pair<const int, const int>>(const std::pair<const int, const int>& v)
             {
                 std::wstringstream str;
                 str << v.first << ", " << v.second;
@@ -68,7 +68,7 @@ namespace Microsoft {
             }
 
             template<> 
-            static std::wstring ToString<amp_stl_algorithms::pair<int, int>>(const amp_stl_algorithms::pair<int, int>& v)
+            inline std::wstring ToString<amp_stl_algorithms::pair<int, int>>(const amp_stl_algorithms::pair<int, int>& v)
             {
                 std::wstringstream str;
                 str << v.first << ", " << v.second;
@@ -278,6 +278,19 @@ namespace amp_stl_algorithms_tests
             Assert::IsTrue(r2);
         }
 
+        TEST_METHOD_CATEGORY(stl_any_of_clears_dest, "stl")
+        {
+            static const int numbers[] = { 1, 3, 6, 3, 2, 2 };
+            static const int n = sizeof(numbers)/sizeof(numbers[0]);
+
+            array_view<const int> av(concurrency::extent<1>(n), numbers);
+            int result = 1;
+            array_view<int> result_av(1, &result);
+            amp_stl_algorithms::any_of(begin(av), end(av), [] (int v) restrict(amp) -> bool { return v > 10; }, begin(result_av));
+            result_av.synchronize();
+            Assert::AreEqual(0, result);
+        }
+
         TEST_METHOD_CATEGORY(stl_all_of, "stl")
         {
             static const int numbers[] = { 1, 3, 6, 3, 2, 2 };
@@ -290,6 +303,55 @@ namespace amp_stl_algorithms_tests
             Assert::IsFalse(r2);
         }
 
+        // Runs test on inputs holding 0, 1, 2, ... with sizes from a single element to many tiles of the searches and
+        // reductions. Most of the sizes are not a multiple of the tile sizes, so the last tile is only partly full.
+        template <typename Func>
+        void test_multi_tile_sizes(const Func& test)
+        {
+            for (int size : { 1, 255, 256, 257, 511, 513, 4097, test_array_size<int>() * 8, test_array_size<int>() * 8 + 1 })
+            {
+                std::vector<int> input(size);
+                std::iota(begin(input), end(input), 0);
+                array_view<const int> av(size, input);
+                test(av);
+            }
+        }
+
+        TEST_METHOD_CATEGORY(stl_all_of_any_of_none_of_multi_tile, "stl")
+        {
+            test_multi_tile_sizes([](const array_view<const int>& av)
+            {
+                // Only the last element decides all_of and any_of, and nothing matches for none_of.
+                const int last_value = av.extent[0] - 1;
+                int result = -1;
+                array_view<int> result_av(1, &result);
+                amp_stl_algorithms::all_of(begin(av), end(av), [=] (int v) restrict(amp) -> bool { return v < last_value; }, begin(result_av));
+                result_av.synchronize();
+                Assert::AreEqual(0, result);
+                amp_stl_algorithms::any_of(begin(av), end(av), [=] (int v) restrict(amp) -> bool { return v == last_value; }, begin(result_av));
+                result_av.synchronize();
+                Assert::AreEqual(1, result);
+                amp_stl_algorithms::none_of(begin(av), end(av), [] (int v) restrict(amp) -> bool { return v < 0; }, begin(result_av));
+                result_av.synchronize();
+                Assert::AreEqual(1, result);
+            });
+        }
+
+        TEST_METHOD_CATEGORY(stl_all_of_any_of_none_of_async, "stl")
+        {
+            std::vector<int> input(test_array_size<int>() * 8);
+            std::iota(begin(input), end(input), 0);
+            array_view<const int> av(int(input.size()), input);
+
+            std::future<bool> all_positive = amp_stl_algorithms::all_of_async(begin(av), end(av), [] (int v) restrict(amp) -> bool { return v >= 0; });
+            std::future<bool> any_first = amp_stl_algorithms::any_of_async(begin(av), end(av), [] (int v) restrict(amp) -> bool { return v == 0; });
+            std::future<bool> none_first = amp_stl_algorithms::none_of_async(begin(av), end(av), [] (int v) restrict(amp) -> bool { return v == 0; });
+
+            Assert::IsTrue(all_positive.get());
+            Assert::IsTrue(any_first.get());
+            Assert::IsFalse(none_first.get());
+        }
+
         //----------------------------------------------------------------------------
         // copy, copy_if, copy_n, copy_backward
         //----------------------------------------------------------------------------
@@ -433,6 +495,20 @@ namespace amp_stl_algorithms_tests
             Assert::AreEqual(0, r2);
         }
 
+        TEST_METHOD_CATEGORY(stl_count_if_multi_tile, "stl")
+        {
+            test_multi_tile_sizes([](const array_view<const int>& av)
+            {
+                const int size = av.extent[0];
+                const int last_value = size - 1;
+
+                auto result = amp_stl_algorithms::count_if(begin(av), end(av), [=](const int& v) restrict(amp) { return (v % 3) == 0; });
+                Assert::AreEqual((size + 2) / 3, result);
+                result = amp_stl_algorithms::count_if(begin(av), end(av), [=](const int& v) restrict(amp) { return v == last_value; });
+                Assert::AreEqual(1, result);
+            });
+        }
+
         //----------------------------------------------------------------------------
         // equal
         //----------------------------------------------------------------------------
@@ -743,6 +819,20 @@ namespace amp_stl_algorithms_tests
             Assert::IsTrue(end(av) == iter);
         }
 
+        TEST_METHOD_CATEGORY(stl_find_if_multi_tile, "stl")
+        {
+            test_multi_tile_sizes([](const array_view<const int>& av)
+            {
+                // The search finishes early for the first match and scans the whole input for the last or for none.
+                const int size = av.extent[0];
+                for (int expected : { 0, size / 2, size - 1, size })
+                {
+                    auto iter = amp_stl_algorithms::find_if(begin(av), end(av), [=](int v) restrict(amp) { return v >= expected; });
+                    Assert::AreEqual(expected, std::distance(begin(av), iter));
+                }
+            });
+        }
+
         TEST_METHOD_CATEGORY(stl_adjacent_find, "stl")
         {
             const int size = 10;
@@ -782,6 +872,20 @@ namespace amp_stl_algorithms_tests
             Assert::AreEqual(1024 * 2, sum);
         }
 
+        TEST_METHOD_CATEGORY(stl_for_each, "stl")
+        {
+            std::vector<int> vec(1024);
+            std::fill(vec.begin(), vec.end(), 2);
+            array_view<const int> av(1024, vec);
+            int sum = 0;
+            array_view<int> av_sum(1, &sum);
+            amp_stl_algorithms::for_each(begin(av), end(av), [av_sum] (int val) restrict(amp) {
+                concurrency::atomic_fetch_add(&av_sum(0), val);
+            });
+            av_sum.synchronize();
+            Assert::AreEqual(1024 * 2, sum);
+        }
+
         //----------------------------------------------------------------------------
         // generate, generate_n
         //----------------------------------------------------------------------------
@@ -867,6 +971,124 @@ namespace amp_stl_algorithms_tests
             });
         }
 
+        //----------------------------------------------------------------------------
+        // mismatch
+        //----------------------------------------------------------------------------
+
+        TEST_METHOD_CATEGORY(stl_mismatch, "stl")
+        {
+            std::vector<int> vec1(test_array_size<int>() * 8);
+            std::iota(begin(vec1), end(vec1), 1);
+            std::vector<int> vec2(vec1);
+            vec2[5000] = 0;
+            vec2[6000] = 0;
+            array_view<const int> av1(int(vec1.size()), vec1);
+            array_view<const int> av2(int(vec2.size()), vec2);
+
+            auto result = amp_stl_algorithms::mismatch(begin(av1), end(av1), begin(av2));
+            Assert::AreEqual(5000, std::distance(begin(av1), result.first));
+            Assert::AreEqual(5000, std::distance(begin(av2), result.second));
+
+            result = amp_stl_algorithms::mismatch(begin(av1), begin(av1) + 5000, begin(av2));
+            Assert::IsTrue(result.first == begin(av1) + 5000);
+        }
+
+        TEST_METHOD_CATEGORY(stl_mismatch_pred, "stl")
+        {
+            std::vector<int> vec1(1024);
+            std::iota(begin(vec1), end(vec1), 1);
+            std::vector<int> vec2(1024);
+            std::iota(begin(vec2), end(vec2), 2);
+            vec2[700] = 0;
+            array_view<const int> av1(1024, vec1);
+            array_view<const int> av2(1024, vec2);
+
+            auto result = amp_stl_algorithms::mismatch(begin(av1), end(av1), begin(av2), [=](const int& v1, const int& v2) restrict(amp) { return ((v1 + 1) == v2); });
+
+            Assert::AreEqual(700, std::distance(begin(av1), result.first));
+        }
+
+        TEST_METHOD_CATEGORY(stl_equal_mismatch_multi_tile, "stl")
+        {
+            test_multi_tile_sizes([](const array_view<const int>& av)
+            {
+                const int size = av.extent[0];
+                for (int expected : { 0, size / 2, size - 1 })
+                {
+                    std::vector<int> other(size);
+                    std::iota(begin(other), end(other), 0);
+                    other[expected] = -1;
+                    array_view<const int> other_av(size, other);
+
+                    auto result = amp_stl_algorithms::mismatch(begin(av), end(av), begin(other_av));
+                    Assert::AreEqual(expected, std::distance(begin(av), result.first));
+                    Assert::IsFalse(amp_stl_algorithms::equal(begin(av), end(av), begin(other_av)));
+                }
+                Assert::IsTrue(amp_stl_algorithms::equal(begin(av), end(av), begin(av)));
+            });
+        }
+
+        //----------------------------------------------------------------------------
+        // partition, stable_partition, partition_point, is_partitioned
+        //----------------------------------------------------------------------------
+
+        TEST_METHOD_CATEGORY(stl_is_partitioned, "stl")
+        {
+            std::array<int, 10> partitioned = { 2, 4, 0, 8, 6, 1, 3, 7, 5, 9 };
+            std::array<int, 10> not_partitioned = { 2, 4, 0, 8, 1, 6, 3, 7, 5, 9 };
+            array_view<const int> partitioned_av(int(partitioned.size()), partitioned);
+            array_view<const int> not_partitioned_av(int(not_partitioned.size()), not_partitioned);
+            auto is_even = [](int v) restrict(amp) { return (v % 2) == 0; };
+
+            Assert::IsTrue(amp_stl_algorithms::is_partitioned(begin(partitioned_av), end(partitioned_av), is_even));
+            Assert::IsFalse(amp_stl_algorithms::is_partitioned(begin(not_partitioned_av), end(not_partitioned_av), is_even));
+        }
+
+        TEST_METHOD_CATEGORY(stl_partition, "stl")
+        {
+            std::vector<int> input(test_array_size<int>());
+            generate_data(input);
+            std::vector<int> expected(input);
+            const auto expected_point = std::partition(begin(expected), end(expected), [](int v) { return v < 0; });
+            array_view<int> input_av(int(input.size()), input);
+
+            auto result_point = amp_stl_algorithms::partition(begin(input_av), end(input_av), [](int v) restrict(amp) { return v < 0; });
+            input_av.synchronize();
+
+            Assert::AreEqual(int(std::distance(begin(expected), expected_point)), std::distance(begin(input_av), result_point));
+            Assert::IsTrue(std::is_partitioned(begin(input), end(input), [](int v) { return v < 0; }));
+            std::sort(begin(expected), end(expected));
+            std::sort(begin(input), end(input));
+            Assert::IsTrue(expected == input);
+        }
+
+        TEST_METHOD_CATEGORY(stl_stable_partition, "stl")
+        {
+            std::vector<int> input(test_array_size<int>());
+            generate_data(input);
+            std::vector<int> expected(input);
+            const auto expected_point = std::stable_partition(begin(expected), end(expected), [](int v) { return (v % 3) == 0; });
+            array_view<int> input_av(int(input.size()), input);
+
+            auto result_point = amp_stl_algorithms::stable_partition(begin(input_av), end(input_av), [](int v) restrict(amp) { return (v % 3) == 0; });
+
+            Assert::AreEqual(int(std::distance(begin(expected), expected_point)), std::distance(begin(input_av), result_point));
+            Assert::IsTrue(are_equal(expected, input_av));
+        }
+
+        TEST_METHOD_CATEGORY(stl_partition_point, "stl")
+        {
+            std::vector<int> input(test_array_size<int>());
+            generate_data(input);
+            std::partition(begin(input), end(input), [](int v) { return v < 0; });
+            const auto expected = std::partition_point(begin(input), end(input), [](int v) { return v < 0; });
+            array_view<const int> input_av(int(input.size()), input);
+
+            auto result = amp_stl_algorithms::partition_point(begin(input_av), end(input_av), [](int v) restrict(amp) { return v < 0; });
+
+            Assert::AreEqual(int(std::distance(begin(input), expected)), std::distance(begin(input_av), result));
+        }
+
         //----------------------------------------------------------------------------
         // reduce
         //----------------------------------------------------------------------------
@@ -934,6 +1156,15 @@ namespace amp_stl_algorithms_tests
             test_remove_if(begin(numbers4), end(numbers4));
         }
 
+        TEST_METHOD_CATEGORY(stl_remove_if_multi_tile, "stl")
+        {
+            // Removes all the positive elements in place across many tiles.
+
+            std::vector<int> numbers(test_array_size<int>() * 3 + 17);
+            generate_data(numbers);
+            test_remove_if(begin(numbers), end(numbers));
+        }
+
         // Customer reported bug. 
         // See: http://social.msdn.stl_remove_if_performance.com/Forums/vstudio/en-US/d959e3f3-2a85-4646-9c54-cae69c534b64
         BEGIN_TEST_METHOD_ATTRIBUTE(stl_remove_if_performance)
@@ -1170,6 +1401,7 @@ namespace amp_stl_algorithms_tests
         TEST_METHOD_CATEGORY(stl_reverse, "stl")
         {
             test_reverse(1);
+            test_reverse(8);
             test_reverse(1023);
             test_reverse(1024);
         }
@@ -1276,6 +1508,496 @@ namespace amp_stl_algorithms_tests
             Assert::IsTrue(amp_stl_algorithms::is_sorted(begin(av), begin(av) + 1));
         }
 
+        TEST_METHOD_CATEGORY(stl_sort, "stl")
+        {
+            std::vector<int> vec(1023);
+            generate_data(vec);
+            std::vector<int> expected(vec);
+            std::sort(begin(expected), end(expected));
+            array_view<int> av(int(vec.size()), vec);
+
+            amp_stl_algorithms::sort(begin(av), end(av));
+
+            Assert::IsTrue(are_equal(expected, av));
+        }
+
+        TEST_METHOD_CATEGORY(stl_sort_greater, "stl")
+        {
+            std::vector<float> vec(1023);
+            generate_data(vec);
+            std::vector<float> expected(vec);
+            std::sort(begin(expected), end(expected), std::greater<float>());
+            array_view<float> av(int(vec.size()), vec);
+
+            amp_stl_algorithms::sort(begin(av), end(av), amp_algorithms::greater<float>());
+
+            Assert::IsTrue(are_equal(expected, av));
+        }
+
+        TEST_METHOD_CATEGORY(stl_stable_sort, "stl")
+        {
+            // Sorting by absolute value leaves equal values in their original order.
+            std::vector<int> vec(1023);
+            generate_data(vec);
+            std::transform(begin(vec), end(vec), begin(vec), [](int v) { return v % 50; });
+            std::vector<int> expected(vec);
+            std::stable_sort(begin(expected), end(expected), [](int a, int b) { return std::abs(a) < std::abs(b); });
+            array_view<int> av(int(vec.size()), vec);
+
+            amp_stl_algorithms::stable_sort(begin(av), end(av), [](int a, int b) restrict(cpu, amp) { return ((a < 0) ? -a : a) < ((b < 0) ? -b : b); });
+
+            Assert::IsTrue(are_equal(expected, av));
+        }
+
+        TEST_METHOD_CATEGORY(stl_partial_sort, "stl")
+        {
+            std::vector<int> vec(1023);
+            generate_data(vec);
+            std::vector<int> expected(vec);
+            std::partial_sort(begin(expected), begin(expected) + 10, end(expected));
+            array_view<int> av(int(vec.size()), vec);
+
+            amp_stl_algorithms::partial_sort(begin(av), begin(av) + 10, end(av));
+
+            for (int i = 0; i < 10; ++i)
+            {
+                Assert::AreEqual(expected[i], av[i]);
+            }
+        }
+
+        TEST_METHOD_CATEGORY(stl_partial_sort_greater_double, "stl")
+        {
+            std::vector<double> vec(1023);
+            generate_data(vec);
+            std::vector<double> expected(vec);
+            std::partial_sort(begin(expected), begin(expected) + 10, end(expected), std::greater<double>());
+            array_view<double> av(int(vec.size()), vec);
+
+            amp_stl_algorithms::partial_sort(begin(av), begin(av) + 10, end(av), amp_algorithms::greater<double>());
+
+            for (int i = 0; i < 10; ++i)
+            {
+                Assert::AreEqual(expected[i], av[i]);
+            }
+        }
+
+        TEST_METHOD_CATEGORY(stl_partial_sort_copy, "stl")
+        {
+            std::vector<int> vec(1023);
+            generate_data(vec);
+            std::vector<int> input(vec);
+            std::vector<int> result(10, -1);
+            std::vector<int> expected(10);
+            std::partial_sort_copy(begin(vec), end(vec), begin(expected), end(expected));
+            array_view<const int> av(int(vec.size()), vec);
+            array_view<int> result_av(int(result.size()), result);
+
+            auto result_last = amp_stl_algorithms::partial_sort_copy(begin(av), end(av), begin(result_av), end(result_av));
+
+            Assert::AreEqual(10, std::distance(begin(result_av), result_last));
+            Assert::IsTrue(are_equal(expected, result_av));
+            Assert::IsTrue(are_equal(input, av));
+        }
+
+        //----------------------------------------------------------------------------
+        // nth_element, top_k
+        //----------------------------------------------------------------------------
+
+        TEST_METHOD_CATEGORY(stl_nth_element, "stl")
+        {
+            std::vector<int> vec(10000);
+            generate_data(vec);
+            std::vector<int> expected(vec);
+            std::nth_element(begin(expected), begin(expected) + 5000, end(expected));
+            array_view<int> av(int(vec.size()), vec);
+
+            amp_stl_algorithms::nth_element(begin(av), begin(av) + 5000, end(av));
+            av.synchronize();
+
+            Assert::AreEqual(expected[5000], vec[5000]);
+            Assert::IsTrue(std::all_of(begin(vec), begin(vec) + 5000, [&](int v) { return v <= vec[5000]; }));
+            Assert::IsTrue(std::all_of(begin(vec) + 5000, end(vec), [&](int v) { return v >= vec[5000]; }));
+        }
+
+        TEST_METHOD_CATEGORY(stl_nth_element_greater_float, "stl")
+        {
+            std::vector<float> vec(10000);
+            generate_data(vec);
+            std::vector<float> expected(vec);
+            std::nth_element(begin(expected), begin(expected) + 100, end(expected), std::greater<float>());
+            array_view<float> av(int(vec.size()), vec);
+
+            amp_stl_algorithms::nth_element(begin(av), begin(av) + 100, end(av), amp_algorithms::greater<float>());
+            av.synchronize();
+
+            Assert::AreEqual(expected[100], vec[100]);
+            Assert::IsTrue(std::all_of(begin(vec), begin(vec) + 100, [&](float v) { return v >= vec[100]; }));
+            Assert::IsTrue(std::all_of(begin(vec) + 100, end(vec), [&](float v) { return v <= vec[100]; }));
+        }
+
+        TEST_METHOD_CATEGORY(stl_top_k, "stl")
+        {
+            std::vector<int> vec(10000);
+            generate_data(vec);
+            std::vector<int> expected(vec);
+            std::sort(begin(expected), end(expected), std::greater<int>());
+            expected.resize(100);
+            array_view<const int> av(int(vec.size()), vec);
+            std::vector<int> result(100, -1);
+            array_view<int> result_av(int(result.size()), result);
+
+            auto result_last = amp_stl_algorithms::top_k(begin(av), end(av), 100, begin(result_av));
+
+            Assert::AreEqual(100, std::distance(begin(result_av), result_last));
+            Assert::IsTrue(are_equal(expected, result_av));
+        }
+
+        TEST_METHOD_CATEGORY(stl_top_k_duplicates, "stl")
+        {
+            std::vector<unsigned int> vec(10000);
+            generate_data(vec);
+            std::transform(begin(vec), end(vec), begin(vec), [](unsigned int v) { return v % 10; });
+            std::vector<unsigned int> expected(vec);
+            std::sort(begin(expected), end(expected), std::greater<unsigned int>());
+            expected.resize(1500);
+            array_view<const unsigned int> av(int(vec.size()), vec);
+            std::vector<unsigned int> result(1500);
+            array_view<unsigned int> result_av(int(result.size()), result);
+
+            amp_stl_algorithms::top_k(begin(av), end(av), 1500, begin(result_av));
+
+            Assert::IsTrue(are_equal(expected, result_av));
+        }
+
+        //----------------------------------------------------------------------------
+        // merge, inplace_merge
+        //----------------------------------------------------------------------------
+
+        TEST_METHOD_CATEGORY(stl_merge, "stl")
+        {
+            std::vector<int> vec1(1023);
+            std::vector<int> vec2(2049);
+            generate_data(vec1);
+            generate_data(vec2);
+            std::sort(begin(vec1), end(vec1));
+            std::sort(begin(vec2), end(vec2));
+            std::vector<int> result(vec1.size() + vec2.size(), -1);
+            std::vector<int> expected(result.size());
+            std::merge(begin(vec1), end(vec1), begin(vec2), end(vec2), begin(expected));
+            array_view<const int> av1(int(vec1.size()), vec1);
+            array_view<const int> av2(int(vec2.size()), vec2);
+            array_view<int> result_av(int(result.size()), result);
+
+            auto result_last = amp_stl_algorithms::merge(begin(av1), end(av1), begin(av2), end(av2), begin(result_av));
+
+            Assert::AreEqual(int(result.size()), std::distance(begin(result_av), result_last));
+            Assert::IsTrue(are_equal(expected, result_av));
+        }
+
+        TEST_METHOD_CATEGORY(stl_merge_is_stable, "stl")
+        {
+            struct record
+            {
+                int key;
+                int id;
+            };
+
+            struct record_less
+            {
+                bool operator()(const record& a, const record& b) const restrict(cpu, amp)
+                {
+                    return a.key < b.key;
+                }
+            };
+
+            std::vector<record> vec1(1000);
+            std::vector<record> vec2(1000);
+            for (int i = 0; i < 1000; ++i)
+            {
+                vec1[i].key = i / 10;
+                vec1[i].id = i;
+                vec2[i].key = i / 7;
+                vec2[i].id = 1000 + i;
+            }
+            std::vector<record> result(2000);
+            std::vector<record> expected(2000);
+            std::merge(begin(vec1), end(vec1), begin(vec2), end(vec2), begin(expected), record_less());
+            array_view<const record> av1(int(vec1.size()), vec1);
+            array_view<const record> av2(int(vec2.size()), vec2);
+            array_view<record> result_av(int(result.size()), result);
+
+            amp_stl_algorithms::merge(begin(av1), end(av1), begin(av2), end(av2), begin(result_av), record_less());
+            result_av.synchronize();
+
+            for (int i = 0; i < int(result.size()); ++i)
+            {
+                Assert::AreEqual(expected[i].id, result[i].id);
+            }
+        }
+
+        TEST_METHOD_CATEGORY(stl_inplace_merge, "stl")
+        {
+            std::vector<int> vec(1023);
+            generate_data(vec);
+            std::sort(begin(vec), begin(vec) + 300, std::greater<int>());
+            std::sort(begin(vec) + 300, end(vec), std::greater<int>());
+            std::vector<int> expected(vec);
+            std::inplace_merge(begin(expected), begin(expected) + 300, end(expected), std::greater<int>());
+            array_view<int> av(int(vec.size()), vec);
+
+            amp_stl_algorithms::inplace_merge(begin(av), begin(av) + 300, end(av), amp_algorithms::greater<int>());
+
+            Assert::IsTrue(are_equal(expected, av));
+        }
+
+        //----------------------------------------------------------------------------
+        // lower_bound, upper_bound, equal_range, binary_search
+        //----------------------------------------------------------------------------
+
+        TEST_METHOD_CATEGORY(stl_lower_bound_upper_bound, "stl")
+        {
+            std::vector<int> vec(1023);
+            generate_data(vec);
+            std::sort(begin(vec), end(vec));
+            array_view<const int> av(int(vec.size()), vec);
+
+            for (int value : { vec.front() - 1, vec.front(), vec[500], vec.back(), vec.back() + 1 })
+            {
+                auto expected_lower = std::lower_bound(begin(vec), end(vec), value);
+                auto expected_upper = std::upper_bound(begin(vec), end(vec), value);
+
+                auto lower = amp_stl_algorithms::lower_bound(begin(av), end(av), value);
+                auto upper = amp_stl_algorithms::upper_bound(begin(av), end(av), value);
+
+                Assert::AreEqual(int(std::distance(begin(vec), expected_lower)), std::distance(begin(av), lower));
+                Assert::AreEqual(int(std::distance(begin(vec), expected_upper)), std::distance(begin(av), upper));
+            }
+        }
+
+        TEST_METHOD_CATEGORY(stl_equal_range, "stl")
+        {
+            std::vector<int> vec(1023);
+            generate_data(vec);
+            std::sort(begin(vec), end(vec), std::greater<int>());
+            array_view<const int> av(int(vec.size()), vec);
+
+            auto expected = std::equal_range(begin(vec), end(vec), vec[300], std::greater<int>());
+
+            auto result = amp_stl_algorithms::equal_range(begin(av), end(av), vec[300], amp_algorithms::greater<int>());
+
+            Assert::AreEqual(int(std::distance(begin(vec), expected.first)), std::distance(begin(av), result.first));
+            Assert::AreEqual(int(std::distance(begin(vec), expected.second)), std::distance(begin(av), result.second));
+        }
+
+        TEST_METHOD_CATEGORY(stl_binary_search, "stl")
+        {
+            std::vector<int> vec(1023);
+            std::iota(begin(vec), end(vec), 0);
+            std::transform(begin(vec), end(vec), begin(vec), [](int v) { return v * 2; });
+            array_view<const int> av(int(vec.size()), vec);
+
+            Assert::IsTrue(amp_stl_algorithms::binary_search(begin(av), end(av), 0));
+            Assert::IsTrue(amp_stl_algorithms::binary_search(begin(av), end(av), 500));
+            Assert::IsFalse(amp_stl_algorithms::binary_search(begin(av), end(av), 501));
+            Assert::IsFalse(amp_stl_algorithms::binary_search(begin(av), end(av), -1));
+            Assert::IsFalse(amp_stl_algorithms::binary_search(begin(av), end(av), 2046));
+        }
+
+        TEST_METHOD_CATEGORY(stl_lower_bound_upper_bound_batched, "stl")
+        {
+            std::vector<int> vec(100000);
+            generate_data(vec);
+            std::sort(begin(vec), end(vec));
+            std::vector<int> values(10000);
+            generate_data(values);
+            std::vector<int> expected_lower(values.size());
+            std::vector<int> expected_upper(values.size());
+            std::transform(begin(values), end(values), begin(expected_lower), [&](int v) { return int(std::distance(begin(vec), std::lower_bound(begin(vec), end(vec), v))); });
+            std::transform(begin(values), end(values), begin(expected_upper), [&](int v) { return int(std::distance(begin(vec), std::upper_bound(begin(vec), end(vec), v))); });
+            array_view<const int> av(int(vec.size()), vec);
+            array_view<const int> values_av(int(values.size()), values);
+            std::vector<int> lower(values.size(), -1);
+            std::vector<int> upper(values.size(), -1);
+            array_view<int> lower_av(int(lower.size()), lower);
+            array_view<int> upper_av(int(upper.size()), upper);
+
+            auto lower_last = amp_stl_algorithms::lower_bound(begin(av), end(av), begin(values_av), end(values_av), begin(lower_av));
+            auto upper_last = amp_stl_algorithms::upper_bound(begin(av), end(av), begin(values_av), end(values_av), begin(upper_av));
+
+            Assert::AreEqual(int(values.size()), std::distance(begin(lower_av), lower_last));
+            Assert::AreEqual(int(values.size()), std::distance(begin(upper_av), upper_last));
+            Assert::IsTrue(are_equal(expected_lower, lower_av));
+            Assert::IsTrue(are_equal(expected_upper, upper_av));
+        }
+
+        TEST_METHOD_CATEGORY(stl_equal_range_batched, "stl")
+        {
+            std::vector<int> vec(1023);
+            generate_data(vec);
+            std::sort(begin(vec), end(vec), std::greater<int>());
+            std::vector<int> values(vec);
+            std::reverse(begin(values), end(values));
+            std::vector<int> expected_lower(values.size());
+            std::vector<int> expected_upper(values.size());
+            for (int i = 0; i < int(values.size()); ++i)
+            {
+                auto range = std::equal_range(begin(vec), end(vec), values[i], std::greater<int>());
+                expected_lower[i] = int(std::distance(begin(vec), range.first));
+                expected_upper[i] = int(std::distance(begin(vec), range.second));
+            }
+            array_view<const int> av(int(vec.size()), vec);
+            array_view<const int> values_av(int(values.size()), values);
+            std::vector<int> lower(values.size(), -1);
+            std::vector<int> upper(values.size(), -1);
+            array_view<int> lower_av(int(lower.size()), lower);
+            array_view<int> upper_av(int(upper.size()), upper);
+
+            amp_stl_algorithms::equal_range(begin(av), end(av), begin(values_av), end(values_av), begin(lower_av), begin(upper_av), amp_algorithms::greater<int>());
+
+            Assert::IsTrue(are_equal(expected_lower, lower_av));
+            Assert::IsTrue(are_equal(expected_upper, upper_av));
+        }
+
+        TEST_METHOD_CATEGORY(stl_binary_search_batched, "stl")
+        {
+            std::vector<int> vec(1023);
+            std::iota(begin(vec), end(vec), 0);
+            std::transform(begin(vec), end(vec), begin(vec), [](int v) { return v * 2; });
+            std::vector<int> values(2048);
+            std::iota(begin(values), end(values), -1);
+            std::vector<int> expected(values.size());
+            std::transform(begin(values), end(values), begin(expected), [&](int v) { return std::binary_search(begin(vec), end(vec), v) ? 1 : 0; });
+            array_view<const int> av(int(vec.size()), vec);
+            array_view<const int> values_av(int(values.size()), values);
+            std::vector<int> found(values.size(), -1);
+            array_view<int> found_av(int(found.size()), found);
+
+            amp_stl_algorithms::binary_search(begin(av), end(av), begin(values_av), end(values_av), begin(found_av));
+
+            Assert::IsTrue(are_equal(expected, found_av));
+        }
+
+        //----------------------------------------------------------------------------
+        // set_difference, set_intersection, set_symmetric_difference, set_union
+        //----------------------------------------------------------------------------
+
+        typedef std::vector<int>::const_iterator set_host_iterator;
+        typedef std::vector<int>::iterator set_host_output_iterator;
+        typedef array_view_iterator<const int> set_amp_iterator;
+        typedef array_view_iterator<int> set_amp_output_iterator;
+
+        // Sorted input for a set operation with values in [0, modulo), a small modulo gives long runs of duplicates.
+        std::vector<int> set_operation_input(const int size, const int modulo)
+        {
+            std::vector<int> vec(size);
+            generate_data(vec);
+            std::transform(begin(vec), end(vec), begin(vec), [=](int v) { return std::abs(v) % modulo; });
+            std::sort(begin(vec), end(vec));
+            return vec;
+        }
+
+        template <typename StdSetOperation, typename AmpSetOperation>
+        void test_set_operation(const std::vector<int>& vec1, const std::vector<int>& vec2, const StdSetOperation& std_op, const AmpSetOperation& amp_op)
+        {
+            std::vector<int> expected(vec1.size() + vec2.size());
+            expected.erase(std_op(begin(vec1), end(vec1), begin(vec2), end(vec2), begin(expected)), end(expected));
+            array_view<const int> av1(int(vec1.size()), vec1);
+            array_view<const int> av2(int(vec2.size()), vec2);
+            std::vector<int> result(vec1.size() + vec2.size(), -1);
+            array_view<int> result_av(int(result.size()), result);
+
+            auto result_last = amp_op(begin(av1), end(av1), begin(av2), end(av2), begin(result_av));
+
+            Assert::AreEqual(int(expected.size()), std::distance(begin(result_av), result_last));
+            if (!expected.empty())
+            {
+                Assert::IsTrue(are_equal(expected, result_av.section(0, int(expected.size()))));
+            }
+        }
+
+        // Runs a set operation on inputs with short runs of duplicates and on inputs with runs much longer than a
+        // tile, which cross tile boundaries.
+        template <typename StdSetOperation, typename AmpSetOperation>
+        void test_set_operation(const StdSetOperation& std_op, const AmpSetOperation& amp_op)
+        {
+            test_set_operation(set_operation_input(1023, 100), set_operation_input(2049, 100), std_op, amp_op);
+            test_set_operation(set_operation_input(5000, 3), set_operation_input(3001, 4), std_op, amp_op);
+            test_set_operation(set_operation_input(4097, 1), set_operation_input(1, 1), std_op, amp_op);
+        }
+
+        TEST_METHOD_CATEGORY(stl_set_difference, "stl")
+        {
+            test_set_operation(
+                [](set_host_iterator first1, set_host_iterator last1, set_host_iterator first2, set_host_iterator last2, set_host_output_iterator d_first)
+                {
+                    return std::set_difference(first1, last1, first2, last2, d_first);
+                },
+                [](set_amp_iterator first1, set_amp_iterator last1, set_amp_iterator first2, set_amp_iterator last2, set_amp_output_iterator d_first)
+                {
+                    return amp_stl_algorithms::set_difference(first1, last1, first2, last2, d_first);
+                });
+        }
+
+        TEST_METHOD_CATEGORY(stl_set_intersection, "stl")
+        {
+            test_set_operation(
+                [](set_host_iterator first1, set_host_iterator last1, set_host_iterator first2, set_host_iterator last2, set_host_output_iterator d_first)
+                {
+                    return std::set_intersection(first1, last1, first2, last2, d_first);
+                },
+                [](set_amp_iterator first1, set_amp_iterator last1, set_amp_iterator first2, set_amp_iterator last2, set_amp_output_iterator d_first)
+                {
+                    return amp_stl_algorithms::set_intersection(first1, last1, first2, last2, d_first);
+                });
+        }
+
+        TEST_METHOD_CATEGORY(stl_set_symmetric_difference, "stl")
+        {
+            test_set_operation(
+                [](set_host_iterator first1, set_host_iterator last1, set_host_iterator first2, set_host_iterator last2, set_host_output_iterator d_first)
+                {
+                    return std::set_symmetric_difference(first1, last1, first2, last2, d_first);
+                },
+                [](set_amp_iterator first1, set_amp_iterator last1, set_amp_iterator first2, set_amp_iterator last2, set_amp_output_iterator d_first)
+                {
+                    return amp_stl_algorithms::set_symmetric_difference(first1, last1, first2, last2, d_first);
+                });
+        }
+
+        TEST_METHOD_CATEGORY(stl_set_union, "stl")
+        {
+            test_set_operation(
+                [](set_host_iterator first1, set_host_iterator last1, set_host_iterator first2, set_host_iterator last2, set_host_output_iterator d_first)
+                {
+                    return std::set_union(first1, last1, first2, last2, d_first);
+                },
+                [](set_amp_iterator first1, set_amp_iterator last1, set_amp_iterator first2, set_amp_iterator last2, set_amp_output_iterator d_first)
+                {
+                    return amp_stl_algorithms::set_union(first1, last1, first2, last2, d_first);
+                });
+        }
+
+        TEST_METHOD_CATEGORY(stl_set_intersection_greater, "stl")
+        {
+            std::vector<int> vec1(10000);
+            std::vector<int> vec2(10000);
+            for (int i = 0; i < 10000; ++i)
+            {
+                vec1[i] = 30000 - i * 3;
+                vec2[i] = 20000 - i * 2;
+            }
+
+            test_set_operation(vec1, vec2,
+                [](set_host_iterator first1, set_host_iterator last1, set_host_iterator first2, set_host_iterator last2, set_host_output_iterator d_first)
+                {
+                    return std::set_intersection(first1, last1, first2, last2, d_first, std::greater<int>());
+                },
+                [](set_amp_iterator first1, set_amp_iterator last1, set_amp_iterator first2, set_amp_iterator last2, set_amp_output_iterator d_first)
+                {
+                    return amp_stl_algorithms::set_intersection(first1, last1, first2, last2, d_first, amp_algorithms::greater<int>());
+                });
+        }
+
         //----------------------------------------------------------------------------
         // swap, swap<T, N>, swap_ranges, iter_swap
         //----------------------------------------------------------------------------
@@ -1449,5 +2171,50 @@ namespace amp_stl_algorithms_tests
                 Assert::AreEqual(343 + 323, element);
             }
         }
+
+        TEST_METHOD_CATEGORY(stl_unique, "stl")
+        {
+            std::vector<int> input(test_array_size<int>());
+            generate_data(input);
+            std::transform(begin(input), end(input), begin(input), [](int v) { return v % 3; });
+            std::vector<int> expected(input);
+            expected.erase(std::unique(begin(expected), end(expected)), end(expected));
+            array_view<int> input_av(int(input.size()), input);
+
+            auto result_last = amp_stl_algorithms::unique(begin(input_av), end(input_av));
+
+            Assert::AreEqual(int(expected.size()), std::distance(begin(input_av), result_last));
+            Assert::IsTrue(are_equal(expected, input_av.section(0, int(expected.size()))));
+        }
+
+        TEST_METHOD_CATEGORY(stl_unique_copy, "stl")
+        {
+            std::vector<int> input(test_array_size<int>());
+            generate_data(input);
+            std::sort(begin(input), end(input));
+            std::vector<int> expected(input.size());
+            expected.erase(std::unique_copy(begin(input), end(input), begin(expected)), end(expected));
+            array_view<const int> input_av(int(input.size()), input);
+            std::vector<int> output(input.size(), -1);
+            array_view<int> output_av(int(output.size()), output);
+
+            auto result_last = amp_stl_algorithms::unique_copy(begin(input_av), end(input_av), begin(output_av));
+
+            Assert::AreEqual(int(expected.size()), std::distance(begin(output_av), result_last));
+            Assert::IsTrue(are_equal(expected, output_av.section(0, int(expected.size()))));
+        }
+
+        TEST_METHOD_CATEGORY(stl_unique_pred, "stl")
+        {
+            std::array<int, 12> input = { 1, 3, 12, 15, 17, 21, 5, 8, 9, 33, 31, 30 };
+            std::array<int, 5> expected = { 1, 12, 21, 5, 33 };
+            array_view<int> input_av(int(input.size()), input);
+
+            // Elements are equivalent if they are in the same decade. Only adjacent elements are compared.
+            auto result_last = amp_stl_algorithms::unique(begin(input_av), end(input_av), [](int a, int b) restrict(amp) { return (a / 10) == (b / 10); });
+
+            Assert::AreEqual(int(expected.size()), std::distance(begin(input_av), result_last));
+            Assert::IsTrue(are_equal(expected, input_av.section(0, int(expected.size()))));
+        }
     };
 };// namespace tests
@@ -23,7 +23,11 @@
 
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <iterator>
 #include <CppUnitTest.h>
 
 #include <amp_algorithms.h>
@@ -48,6 +52,31 @@ class extent { };
 class index { };
 class array { };
 
+//  Stand-ins for the Windows functions used by the tests when they are built with the host backend on other platforms.
+
+#if !defined(_WIN32)
+template <size_t N, typename... Args>
+inline int sprintf_s(char (&buffer)[N], const char* format, Args... args)
+{
+    return std::snprintf(buffer, N, format, args...);
+}
+
+union LARGE_INTEGER
+{
+    long long QuadPart;
+};
+
+inline void QueryPerformanceCounter(LARGE_INTEGER* count)
+{
+    count->QuadPart = std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+inline void QueryPerformanceFrequency(LARGE_INTEGER* frequency)
+{
+    frequency->QuadPart = std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num;
+}
+#endif
+
 //  Set USE_REF to use the REF accelerator for all tests. This is useful if tests fail on a particular machine as
 //  failure may be due to a driver bug.
 
@@ -74,7 +103,12 @@ namespace testtools
         str << "Running '" << test_name << "' tests on '" <<
             accelerator().description.c_str() << "', " << accelerator().device_path.c_str() << "." << std::endl;
         Logger::WriteMessage(str.str().c_str());
-        std::cout << str.str().c_str() << std::endl;
+
+        // Written as narrow characters, as a standard output stream cannot mix narrow and wide output on all platforms.
+        const std::wstring message = str.str();
+        std::string narrow_message(message.size(), ' ');
+        std::transform(begin(message), end(message), begin(narrow_message), [](wchar_t c) { return static_cast<char>(c); });
+        std::cout << narrow_message << std::endl;
     }
 
     inline void set_default_accelerator(std::wstring test_name)
@@ -115,12 +149,14 @@ namespace testtools
         return size;
     }
 
+    // The values are limited to 15 bits, the range of rand() with Visual C++, so that the tests see the same range of
+    // values on every platform.
     template <typename T>
     inline void generate_data(std::vector<T> &v)
     {
         srand(2012);    // Set random number seed so tests are reproducible.
         std::generate(begin(v), end(v), [=]{
-            T v = (T)rand();
+            T v = (T)(rand() & 0x7FFF);
             return ((int(v) % 4) == 0) ? -v : v;
         });
     }
@@ -129,7 +165,7 @@ namespace testtools
     inline void generate_data(std::vector<unsigned int> &v)
     {
         srand(2012);    // Set random number seed so tests are reproducible.
-        std::generate(begin(v), end(v), [=](){ return (unsigned int) rand(); });
+        std::generate(begin(v), end(v), [=](){ return (unsigned int) (rand() & 0x7FFF); });
     }
 
     //===============================================================================
@@ -139,7 +175,7 @@ namespace testtools
     template <typename InIt, typename OutIt>
     inline void scan_sequential_exclusive(InIt first, InIt last, OutIt dest_first)
     {
-        typedef InIt::value_type T;
+        typedef typename std::iterator_traits<InIt>::value_type T;
         int previous = T();
         auto result = T();
 
@@ -154,7 +190,7 @@ namespace testtools
     template <typename InIt, typename OutIt>
     inline void scan_sequential_inclusive(InIt first, InIt last, OutIt dest_first)
     {
-        typedef InIt::value_type T;
+        typedef typename std::iterator_traits<InIt>::value_type T;
         auto result = T();
 
         std::transform(first, last, dest_first, [=, &result](const T& v)
@@ -312,6 +348,42 @@ namespace testtools
     //
     // TODO: Should this stream support be part of the library. It seems pretty useful, for debugging and testing if nothing else.
 
+    namespace _details
+    {
+        inline int geti()
+        {
+            static int i = std::ios_base::xalloc();
+            return i;
+        }
+
+        template <typename STREAM>
+        inline size_t get_width(STREAM& os)
+        {
+            const size_t default_width = 4;
+            size_t width = os.iword(geti());
+            return (width == 0) ? default_width : width;
+        }
+
+        template <typename T>
+        inline const T* get_delimiter()
+        {
+            assert(false);
+            return nullptr;
+        }
+
+        template <>
+        inline const char* get_delimiter<char>()
+        {
+            return ",";
+        }
+
+        template <>
+        inline const wchar_t* get_delimiter<wchar_t>()
+        {
+            return L",";
+        }
+    } // namespace _details
+
     class container_width
     {
     public:
@@ -330,11 +402,11 @@ namespace testtools
     };
 
     // TODO: These print two ',' as a delimiter not one. Fix.
-    template<typename StrmType, typename Traits, typename T, int N>
+    template<typename StrmType, typename Traits, typename T, size_t N>
     std::basic_ostream<StrmType, Traits>& operator<< (std::basic_ostream<StrmType, Traits>& os, const std::array<T, N>& vec)
     {
         std::copy(std::begin(vec), std::begin(vec) + std::min<size_t>(_details::get_width(os), vec.size()),
-            std::ostream_iterator<T, Traits::char_type>(os, _details::get_delimiter<Traits::char_type>()));
+            std::ostream_iterator<T, typename Traits::char_type>(os, _details::get_delimiter<typename Traits::char_type>()));
         return os;
     }
 
@@ -342,7 +414,7 @@ namespace testtools
     std::basic_ostream<StrmType, Traits>& operator<< (std::basic_ostream<StrmType, Traits>& os, const std::vector<T>& vec)
     {
         std::copy(std::begin(vec), std::begin(vec) + std::min<size_t>(_details::get_width(os), vec.size()),
-            std::ostream_iterator<T, Traits::char_type>(os, _details::get_delimiter<Traits::char_type>()));
+            std::ostream_iterator<T, typename Traits::char_type>(os, _details::get_delimiter<typename Traits::char_type>()));
         return os;
     }
 
@@ -350,7 +422,7 @@ namespace testtools
     std::basic_ostream<StrmType, Traits>& operator<< (std::basic_ostream<StrmType, Traits>& os, concurrency::array<T, 1>& vec)
     {
         size_t i = std::min<size_t>(_details::get_width(os), vec.extent[0]);
-        std::vector<const T> buffer(i);
+        std::vector<T> buffer(i);
         copy(vec.section(0, int(i)), std::begin(buffer));
         return os << buffer;
     }
@@ -364,44 +436,6 @@ namespace testtools
         return os << buffer;
     }
 
-    namespace _details
-    {
-        inline int geti()
-        {
-            static int i = std::ios_base::xalloc();
-            return i;
-        }
-
-        template <typename STREAM>
-        inline size_t get_width(STREAM& os)
-        {
-            const size_t default_width = 4;
-            size_t width = os.iword(geti());
-            return (width == 0) ? default_width : width;
-        }
-
-        template <typename T>
-        inline T* get_delimiter()
-        {
-            assert(false);
-            return nullptr;
-        }
-
-        template <>
-        inline char* get_delimiter()
-        {
-            static char delim(',');
-            return &delim;
-        }
-
-        template <>
-        inline wchar_t* get_delimiter()
-        {
-            static wchar_t delim(L',');
-            return &delim;
-        }
-    } // namespace _details
-
     //===============================================================================
     //  Basic performance timing.
     //===============================================================================